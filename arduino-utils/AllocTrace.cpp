@@ -0,0 +1,21 @@
+#include "DebugMacros.h"
+#include "DPrint.h"
+
+#include "AllocTrace.h"
+
+namespace SearchAThing
+{
+
+	namespace Arduino
+	{
+
+		void PrintAllocStats(const __FlashStringHelper *name, const SAllocStats& stats)
+		{
+			DLogln(name, F(" allocs="), stats.allocs, F(" frees="), stats.frees,
+				F(" fail="), stats.failures, F(" live="), stats.liveBytes,
+				F(" peak="), stats.peakBytes);
+		}
+
+	}
+
+}
@@ -0,0 +1,81 @@
+#ifndef _SEARCHATHING_ARDUINO_UTILS_ALLOC_TRACE_H
+#define _SEARCHATHING_ARDUINO_UTILS_ALLOC_TRACE_H
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include "DebugMacros.h"
+
+namespace SearchAThing
+{
+
+	namespace Arduino
+	{
+
+		// Allocation counters.
+		struct SAllocStats
+		{
+			// successful allocations
+			uint32_t allocs;
+
+			// deallocations
+			uint32_t frees;
+
+			// failed allocations ( out of memory )
+			uint16_t failures;
+
+			// bytes currently allocated
+			uint16_t liveBytes;
+
+			// max bytes allocated at the same time
+			uint16_t peakBytes;
+
+			void OnAlloc(uint16_t bytes)
+			{
+				++allocs;
+				liveBytes += bytes;
+				if (liveBytes > peakBytes) peakBytes = liveBytes;
+			}
+
+			void OnFree(uint16_t bytes)
+			{
+				++frees;
+				liveBytes -= bytes;
+			}
+
+			void OnFailure()
+			{
+				++failures;
+			}
+		};
+
+		// Allocation counters shared by all allocations traced with the
+		// same `Tag' ( eg. one tag per subsystem or per call site ).
+		template<uint8_t Tag>
+		class SAllocTrace
+		{
+			static SAllocStats stats;
+
+		public:
+			// Counters of the `Tag'.
+			static SAllocStats& Stats() { return stats; }
+
+			// Reset counters of the `Tag'.
+			static void Reset() { stats = SAllocStats(); }
+		};
+
+		template<uint8_t Tag>
+		SAllocStats SAllocTrace<Tag>::stats;
+
+		// Prints given allocation counters prefixed by the given `name'.
+		// Note: Use F("str") to pass argument.
+		void PrintAllocStats(const __FlashStringHelper *name, const SAllocStats& stats);
+
+	}
+
+}
+
+#endif
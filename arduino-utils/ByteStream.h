@@ -0,0 +1,342 @@
+#ifndef _SEARCHATHING_ARDUINO_UTILS_BYTE_STREAM_H
+#define _SEARCHATHING_ARDUINO_UTILS_BYTE_STREAM_H
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include "DebugMacros.h"
+
+namespace SearchAThing
+{
+
+	namespace Arduino
+	{
+
+		//===========================================================================
+		// ENDIAN HELPERS
+		//---------------------------------------------------------------------------
+		// Store/load `N' bytes integers msb first ( BE ) or lsb first ( LE ).
+		// Templates are unrolled at compile time into plain byte moves.
+		//===========================================================================
+
+		template<uint8_t N>
+		struct SBytes
+		{
+			template<class T>
+			static void StoreBE(byte *p, T v)
+			{
+				p[N - 1] = (byte)v;
+				SBytes<N - 1>::StoreBE(p, (T)(v >> 8));
+			}
+
+			template<class T>
+			static void StoreLE(byte *p, T v)
+			{
+				p[0] = (byte)v;
+				SBytes<N - 1>::StoreLE(p + 1, (T)(v >> 8));
+			}
+
+			template<class T>
+			static T LoadBE(const byte *p)
+			{
+				return (T)(SBytes<N - 1>::template LoadBE<T>(p) << 8) | p[N - 1];
+			}
+
+			template<class T>
+			static T LoadLE(const byte *p)
+			{
+				return (T)(SBytes<N - 1>::template LoadLE<T>(p + 1) << 8) | p[0];
+			}
+		};
+
+		template<>
+		struct SBytes<0>
+		{
+			template<class T> static void StoreBE(byte *, T) {}
+			template<class T> static void StoreLE(byte *, T) {}
+			template<class T> static T LoadBE(const byte *) { return 0; }
+			template<class T> static T LoadLE(const byte *) { return 0; }
+		};
+
+		// Raw bits of a float.
+		inline uint32_t FloatBits(float f)
+		{
+			uint32_t res;
+			memcpy(&res, &f, 4);
+			return res;
+		}
+
+		// Float from its raw bits.
+		inline float BitsFloat(uint32_t bits)
+		{
+			float res;
+			memcpy(&res, &bits, 4);
+			return res;
+		}
+
+		//===========================================================================
+		// BYTE WRITER
+		//===========================================================================
+
+		// Writes values sequentially into the given buffer.
+		// Writing beyond the buffer end doesn't write anything and latches
+		// the error flag so that it can be checked once with Ok() after all
+		// writes instead of after each.
+		class ByteWriter
+		{
+			byte *buf;
+			uint16_t size;
+			uint16_t pos = 0;
+			bool error = false;
+
+			template<uint8_t N, class T>
+			void BE(T v)
+			{
+				byte *p = Reserve(N);
+				if (p != NULL) SBytes<N>::StoreBE(p, v);
+			}
+
+			template<uint8_t N, class T>
+			void LE(T v)
+			{
+				byte *p = Reserve(N);
+				if (p != NULL) SBytes<N>::StoreLE(p, v);
+			}
+
+		public:
+			// Writes into the given `buf' of `size' bytes.
+			ByteWriter(byte *_buf, uint16_t _size) : buf(_buf), size(_size) {}
+
+			// Advances the cursor by `n' bytes returning pointer where to
+			// write them or NULL if there isn't enough room.
+			byte *Reserve(uint16_t n)
+			{
+				if (n > size - pos)
+				{
+					error = true;
+					pos = size;
+					return NULL;
+				}
+
+				byte *res = buf + pos;
+				pos += n;
+				return res;
+			}
+
+			// True if all writes fit the buffer.
+			bool Ok() const { return !error; }
+
+			// Number of bytes written.
+			uint16_t Size() const { return pos; }
+
+			// Room left.
+			uint16_t Available() const { return size - pos; }
+
+			// Buffer start.
+			byte *Data() const { return buf; }
+
+			void WriteU8(uint8_t v) { BE<1>(v); }
+			void WriteI8(int8_t v) { BE<1>((uint8_t)v); }
+
+			void WriteU16BE(uint16_t v) { BE<2>(v); }
+			void WriteU16LE(uint16_t v) { LE<2>(v); }
+			void WriteI16BE(int16_t v) { BE<2>((uint16_t)v); }
+			void WriteI16LE(int16_t v) { LE<2>((uint16_t)v); }
+
+			// Writes lower 24 bits of `v'.
+			void WriteU24BE(uint32_t v) { BE<3>(v); }
+			void WriteU24LE(uint32_t v) { LE<3>(v); }
+
+			void WriteU32BE(uint32_t v) { BE<4>(v); }
+			void WriteU32LE(uint32_t v) { LE<4>(v); }
+			void WriteI32BE(int32_t v) { BE<4>((uint32_t)v); }
+			void WriteI32LE(int32_t v) { LE<4>((uint32_t)v); }
+
+			void WriteU64BE(uint64_t v) { BE<8>(v); }
+			void WriteU64LE(uint64_t v) { LE<8>(v); }
+			void WriteI64BE(int64_t v) { BE<8>((uint64_t)v); }
+			void WriteI64LE(int64_t v) { LE<8>((uint64_t)v); }
+
+			// Writes ieee754 single precision float.
+			void WriteFloatBE(float v) { BE<4>(FloatBits(v)); }
+			void WriteFloatLE(float v) { LE<4>(FloatBits(v)); }
+
+			// Writes unsigned integer as varint ( 7 bits per byte lsb first,
+			// msb set on all bytes but the last; 1 to 5 bytes ).
+			void WriteVarint(uint32_t v)
+			{
+				while (v >= 0x80)
+				{
+					WriteU8((byte)v | 0x80);
+					v >>= 7;
+				}
+				WriteU8((byte)v);
+			}
+
+			// Writes signed integer as zigzag varint ( small magnitudes,
+			// negative too, use few bytes ).
+			void WriteSVarint(int32_t v)
+			{
+				WriteVarint(((uint32_t)v << 1) ^ (uint32_t)(v >> 31));
+			}
+
+			// Writes `len' raw bytes.
+			void WriteBytes(const byte *data, uint16_t len)
+			{
+				byte *p = Reserve(len);
+				if (p != NULL) memcpy(p, data, len);
+			}
+
+			// Writes `len' as varint followed by `len' raw bytes.
+			void WriteBlob(const byte *data, uint16_t len)
+			{
+				WriteVarint(len);
+				WriteBytes(data, len);
+			}
+		};
+
+		//===========================================================================
+		// BYTE READER
+		//===========================================================================
+
+		// Reads values sequentially from the given buffer.
+		// Reading beyond the buffer end returns zero values and latches the
+		// error flag so that it can be checked once with Ok() after all
+		// reads instead of after each.
+		class ByteReader
+		{
+			const byte *buf;
+			uint16_t size;
+			uint16_t pos = 0;
+			bool error = false;
+
+			template<uint8_t N, class T>
+			T BE()
+			{
+				const byte *p = Consume(N);
+				return p != NULL ? SBytes<N>::template LoadBE<T>(p) : 0;
+			}
+
+			template<uint8_t N, class T>
+			T LE()
+			{
+				const byte *p = Consume(N);
+				return p != NULL ? SBytes<N>::template LoadLE<T>(p) : 0;
+			}
+
+		public:
+			// Reads from the given `buf' of `size' bytes.
+			ByteReader(const byte *_buf, uint16_t _size) : buf(_buf), size(_size) {}
+
+			// Advances the cursor by `n' bytes returning pointer where to
+			// read them or NULL if there aren't enough bytes.
+			const byte *Consume(uint16_t n)
+			{
+				if (n > size - pos)
+				{
+					error = true;
+					pos = size;
+					return NULL;
+				}
+
+				const byte *res = buf + pos;
+				pos += n;
+				return res;
+			}
+
+			// True if all reads were within the buffer ( and well formed ).
+			bool Ok() const { return !error; }
+
+			// Number of bytes read.
+			uint16_t Position() const { return pos; }
+
+			// Bytes left.
+			uint16_t Available() const { return size - pos; }
+
+			uint8_t ReadU8() { return BE<1, uint8_t>(); }
+			int8_t ReadI8() { return (int8_t)BE<1, uint8_t>(); }
+
+			uint16_t ReadU16BE() { return BE<2, uint16_t>(); }
+			uint16_t ReadU16LE() { return LE<2, uint16_t>(); }
+			int16_t ReadI16BE() { return (int16_t)BE<2, uint16_t>(); }
+			int16_t ReadI16LE() { return (int16_t)LE<2, uint16_t>(); }
+
+			uint32_t ReadU24BE() { return BE<3, uint32_t>(); }
+			uint32_t ReadU24LE() { return LE<3, uint32_t>(); }
+
+			uint32_t ReadU32BE() { return BE<4, uint32_t>(); }
+			uint32_t ReadU32LE() { return LE<4, uint32_t>(); }
+			int32_t ReadI32BE() { return (int32_t)BE<4, uint32_t>(); }
+			int32_t ReadI32LE() { return (int32_t)LE<4, uint32_t>(); }
+
+			uint64_t ReadU64BE() { return BE<8, uint64_t>(); }
+			uint64_t ReadU64LE() { return LE<8, uint64_t>(); }
+			int64_t ReadI64BE() { return (int64_t)BE<8, uint64_t>(); }
+			int64_t ReadI64LE() { return (int64_t)LE<8, uint64_t>(); }
+
+			float ReadFloatBE() { return BitsFloat(BE<4, uint32_t>()); }
+			float ReadFloatLE() { return BitsFloat(LE<4, uint32_t>()); }
+
+			// Reads varint written by ByteWriter::WriteVarint ( values not fitting
+			// 32 bits set the error ).
+			uint32_t ReadVarint()
+			{
+				uint32_t res = 0;
+
+				for (uint8_t shift = 0; shift < 35; shift += 7)
+				{
+					byte b = ReadU8();
+
+					// 5th byte carries bits 28..31 only
+					if (shift == 28 && (b & 0x70))
+					{
+						error = true;
+						return 0;
+					}
+
+					res |= (uint32_t)(b & 0x7f) << shift;
+					if (!(b & 0x80)) return res;
+				}
+
+				// more than 5 bytes
+				error = true;
+				return 0;
+			}
+
+			// Reads zigzag varint written by ByteWriter::WriteSVarint.
+			int32_t ReadSVarint()
+			{
+				uint32_t v = ReadVarint();
+				return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+			}
+
+			// Copies `len' raw bytes into `data'.
+			void ReadBytes(byte *data, uint16_t len)
+			{
+				const byte *p = Consume(len);
+				if (p != NULL) memcpy(data, p, len); else memset(data, 0, len);
+			}
+
+			// Reads a blob written by ByteWriter::WriteBlob without copying it:
+			// `data' is set to point inside the buffer. Returns blob length.
+			uint16_t ReadBlob(const byte *&data)
+			{
+				uint32_t len = ReadVarint();
+				data = len <= 0xffff ? Consume((uint16_t)len) : NULL;
+				if (data == NULL)
+				{
+					error = true;
+					return 0;
+				}
+				return (uint16_t)len;
+			}
+		};
+
+	}
+
+}
+
+#endif
@@ -0,0 +1,163 @@
+#include "DebugMacros.h"
+
+#include "DCbor.h"
+#include "Util.h"
+
+#ifdef DPRINT_SERIAL
+
+namespace SearchAThing
+{
+
+namespace Arduino
+{
+
+// Writes an item head of given major type and argument using the
+// shortest encoding.
+static void _DCborHead(byte major, uint32_t v)
+{
+	byte head[5];
+	uint8_t len;
+
+	major <<= 5;
+
+	if (v < 24)
+	{
+		head[0] = major | v;
+		len = 1;
+	}
+	else if (v <= 0xff)
+	{
+		head[0] = major | 24;
+		head[1] = v;
+		len = 2;
+	}
+	else if (v <= 0xffff)
+	{
+		head[0] = major | 25;
+		BufWrite16(head + 1, v);
+		len = 3;
+	}
+	else
+	{
+		head[0] = major | 26;
+		BufWrite32(head + 1, v);
+		len = 5;
+	}
+
+	DPrintStrn((const char *)head, len);
+}
+
+// Writes a single byte item.
+static void _DCborByte(byte b)
+{
+	DPrintStrn((const char *)&b, 1);
+}
+
+//--
+
+void DCborMap(uint16_t n)
+{
+	_DCborHead(DCBOR_MAP, n);
+}
+
+void DCborMapBegin()
+{
+	_DCborByte((DCBOR_MAP << 5) | 31);
+}
+
+void DCborArray(uint16_t n)
+{
+	_DCborHead(DCBOR_ARRAY, n);
+}
+
+void DCborArrayBegin()
+{
+	_DCborByte((DCBOR_ARRAY << 5) | 31);
+}
+
+void DCborBreak()
+{
+	_DCborByte(0xff);
+}
+
+//--
+
+void DCborUInt(uint32_t v)
+{
+	_DCborHead(DCBOR_UINT, v);
+}
+
+void DCborInt(int32_t v)
+{
+	if (v < 0)
+		// -1 - v doesn't overflow for any negative int32
+		_DCborHead(DCBOR_NINT, (uint32_t)(-1 - v));
+	else
+		_DCborHead(DCBOR_UINT, v);
+}
+
+void DCborFloat(float v)
+{
+	byte item[5];
+	uint32_t bits;
+	memcpy(&bits, &v, 4);
+
+	item[0] = (DCBOR_SIMPLE << 5) | 26;
+	BufWrite32(item + 1, bits);
+
+	DPrintStrn((const char *)item, 5);
+}
+
+void DCborBool(bool v)
+{
+	_DCborByte((DCBOR_SIMPLE << 5) | (v ? 21 : 20));
+}
+
+void DCborNull()
+{
+	_DCborByte((DCBOR_SIMPLE << 5) | 22);
+}
+
+//--
+
+void DCborBytes(const byte *buf, uint16_t len)
+{
+	_DCborHead(DCBOR_BYTES, len);
+	DPrintStrn((const char *)buf, len);
+}
+
+void DCborStr(const char *str)
+{
+	DCborStrn(str, strlen(str));
+}
+
+void DCborStrn(const char *str, uint16_t size)
+{
+	_DCborHead(DCBOR_TEXT, size);
+	DPrintStrn(str, size);
+}
+
+void DCborF(const __FlashStringHelper *str)
+{
+	const char *p = (const char *)str;
+	uint16_t len = 0;
+	while (pgm_read_byte(p + len))
+		++len;
+
+	_DCborHead(DCBOR_TEXT, len);
+	DPrintF(str);
+}
+
+//--
+
+void DCborKeyUInt(uint8_t key, uint32_t v)
+{
+	_DCborHead(DCBOR_UINT, key);
+	_DCborHead(DCBOR_UINT, v);
+}
+
+} // namespace Arduino
+
+} // namespace SearchAThing
+
+#endif // DPRINT_SERIAL
@@ -0,0 +1,112 @@
+#ifndef _SEARCHATHING_ARDUINO_UTILS_DCBOR_H
+#define _SEARCHATHING_ARDUINO_UTILS_DCBOR_H
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include "DebugMacros.h"
+
+//===========================================================================
+// CBOR TELEMETRY ( RFC 8949 )
+//---------------------------------------------------------------------------
+// DCbor functions stream CBOR items straight to the DPrint sink without an
+// intermediate buffer, eg. a map of 2 entries:
+//
+//   DCborMap(2);
+//   DCborF(F("blk")); DCborUInt(FreeMemoryMaxBlock());
+//   DCborF(F("t")); DCborFloat(21.5);
+//
+// containers of unknown size can be opened with DCborMapBegin /
+// DCborArrayBegin and closed with DCborBreak.
+// Note: the output is binary; don't mix it with text on the same sink
+// unless the receiver can split them.
+//===========================================================================
+
+#define DCBOR_UINT 0
+#define DCBOR_NINT 1
+#define DCBOR_BYTES 2
+#define DCBOR_TEXT 3
+#define DCBOR_ARRAY 4
+#define DCBOR_MAP 5
+#define DCBOR_SIMPLE 7
+
+namespace SearchAThing
+{
+
+namespace Arduino
+{
+
+// Starts a map of `n' key/value pairs ( 2*n items follow ).
+void DCborMap(uint16_t n);
+
+// Starts a map of unknown size ( close with DCborBreak ).
+void DCborMapBegin();
+
+// Starts an array of `n' items.
+void DCborArray(uint16_t n);
+
+// Starts an array of unknown size ( close with DCborBreak ).
+void DCborArrayBegin();
+
+// Closes a container started with DCborMapBegin / DCborArrayBegin.
+void DCborBreak();
+
+// Writes unsigned integer ( shortest of 1, 2, 3, 5 bytes ).
+void DCborUInt(uint32_t v);
+
+// Writes signed integer ( shortest of 1, 2, 3, 5 bytes ).
+void DCborInt(int32_t v);
+
+// Writes single precision float ( 5 bytes ).
+void DCborFloat(float v);
+
+void DCborBool(bool v);
+
+void DCborNull();
+
+// Writes `len' bytes as byte string.
+void DCborBytes(const byte *buf, uint16_t len);
+
+// Writes null terminated string as text string.
+void DCborStr(const char *str);
+
+// Writes `size' chars of given string as text string.
+void DCborStrn(const char *str, uint16_t size);
+
+// Writes flash string as text string ( eg. map keys ).
+// Note: Use F("str") to pass argument.
+void DCborF(const __FlashStringHelper *str);
+
+// Writes a map entry with small integer `key' ( 0..23 takes 1 byte ) and
+// unsigned value; compact telemetry maps use integer keys documented by
+// their writer instead of names.
+void DCborKeyUInt(uint8_t key, uint32_t v);
+
+} // namespace Arduino
+
+} // namespace SearchAThing
+
+#ifndef DPRINT_SERIAL
+
+#define DCborMap(x) ;
+#define DCborMapBegin() ;
+#define DCborArray(x) ;
+#define DCborArrayBegin() ;
+#define DCborBreak() ;
+#define DCborUInt(x) ;
+#define DCborInt(x) ;
+#define DCborFloat(x) ;
+#define DCborBool(x) ;
+#define DCborNull() ;
+#define DCborBytes(x, ...) ;
+#define DCborStr(x) ;
+#define DCborStrn(x, ...) ;
+#define DCborF(x) ;
+#define DCborKeyUInt(x, ...) ;
+
+#endif
+
+#endif
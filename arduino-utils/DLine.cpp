@@ -0,0 +1,242 @@
+#include "DebugMacros.h"
+
+#include "DLine.h"
+#include "DPrint.h"
+#include "Util.h"
+
+namespace SearchAThing
+{
+
+	namespace Arduino
+	{
+
+		void DLineBase::Flush()
+		{
+			DPrintStrn(buf, len);
+			len = 0;
+		}
+
+		bool DLineBase::Fit(uint16_t n)
+		{
+			if (truncated) return false;
+			if (n <= size - len) return true;
+
+			if (flush)
+			{
+				Flush();
+				return true;
+			}
+
+			truncated = true;
+			return false;
+		}
+
+		void DLineBase::Put(const char *s, uint16_t n)
+		{
+			while (n > 0)
+			{
+				if (len == size) Flush();
+
+				uint16_t k = size - len;
+				if (k > n) k = n;
+				memcpy(buf + len, s, k);
+				len += k;
+				s += k;
+				n -= k;
+			}
+		}
+
+		void DLineBase::PutX(char c, uint16_t n)
+		{
+			while (n > 0)
+			{
+				if (len == size) Flush();
+
+				uint16_t k = size - len;
+				if (k > n) k = n;
+				memset(buf + len, c, k);
+				len += k;
+				n -= k;
+			}
+		}
+
+		DLineBase& DLineBase::Padded(const char *s, uint8_t n, uint8_t width, char pad)
+		{
+			uint8_t w = width > n ? width : n;
+			if (!Fit(w)) return *this;
+
+			if (w > n)
+			{
+				if (pad == '0' && *s == '-')
+				{
+					Put(s, 1);
+					++s;
+					--n;
+					--w;
+				}
+				PutX(pad, w - n);
+			}
+			Put(s, n);
+
+			return *this;
+		}
+
+		//--
+
+		DLineBase& DLineBase::Char(char c)
+		{
+			if (Fit(1)) Put(&c, 1);
+			return *this;
+		}
+
+		DLineBase& DLineBase::CharX(char c, uint16_t cnt)
+		{
+			if (Fit(cnt)) PutX(c, cnt);
+			return *this;
+		}
+
+		DLineBase& DLineBase::Strn(const char *str, uint16_t n)
+		{
+			if (truncated) return *this;
+
+			if (!flush && n > size - len)
+			{
+				// cut to the room left
+				Put(str, size - len);
+				truncated = true;
+			}
+			else
+				Put(str, n);
+
+			return *this;
+		}
+
+		DLineBase& DLineBase::Str(const char *str)
+		{
+			return Strn(str, strlen(str));
+		}
+
+		DLineBase& DLineBase::Flash(const __FlashStringHelper *str)
+		{
+			const char *p = reinterpret_cast<const char *>(str);
+			char c;
+
+			if (truncated) return *this;
+
+			while ((c = pgm_read_byte(p++)) != 0)
+			{
+				if (len == size)
+				{
+					if (!flush)
+					{
+						truncated = true;
+						break;
+					}
+					Flush();
+				}
+				buf[len++] = c;
+			}
+
+			return *this;
+		}
+
+		DLineBase& DLineBase::Bool(bool b)
+		{
+			return Char(b ? '1' : '0');
+		}
+
+		//--
+
+		DLineBase& DLineBase::Byte(byte b, uint8_t width, char pad)
+		{
+			return UInt16(b, width, pad);
+		}
+
+		DLineBase& DLineBase::UInt16(uint16_t v, uint8_t width, char pad)
+		{
+			char s[5];
+			return Padded(s, UInt16ToDec(s, v) - s, width, pad);
+		}
+
+		DLineBase& DLineBase::Int16(int16_t v, uint8_t width, char pad)
+		{
+			char s[6];
+			return Padded(s, Int16ToDec(s, v) - s, width, pad);
+		}
+
+		DLineBase& DLineBase::UInt32(uint32_t v, uint8_t width, char pad)
+		{
+			char s[10];
+			return Padded(s, UInt32ToDec(s, v) - s, width, pad);
+		}
+
+		DLineBase& DLineBase::Int32(int32_t v, uint8_t width, char pad)
+		{
+			char s[11];
+			return Padded(s, Int32ToDec(s, v) - s, width, pad);
+		}
+
+		DLineBase& DLineBase::Float(float v, int prec)
+		{
+			char s[20];
+			FloatToString(s, v, prec);
+			return Padded(s, strlen(s), 0, ' ');
+		}
+
+		//--
+
+		DLineBase& DLineBase::Hex(byte b)
+		{
+			char s[2];
+			ByteToHex(s, b);
+			return Padded(s, 2, 0, ' ');
+		}
+
+		DLineBase& DLineBase::Hex(uint16_t v, bool prefix)
+		{
+			char s[6];
+			char *p = s;
+			if (prefix)
+			{
+				*p++ = '0';
+				*p++ = 'x';
+			}
+			p = ByteToHex(p, highByte(v));
+			p = ByteToHex(p, lowByte(v));
+			return Padded(s, p - s, 0, ' ');
+		}
+
+		DLineBase& DLineBase::Hex(unsigned long v, bool prefix)
+		{
+			char s[10];
+			char *p = s;
+			if (prefix)
+			{
+				*p++ = '0';
+				*p++ = 'x';
+			}
+			p = ByteToHex(p, (byte)(v >> 24));
+			p = ByteToHex(p, (byte)(v >> 16));
+			p = ByteToHex(p, (byte)(v >> 8));
+			p = ByteToHex(p, (byte)v);
+			return Padded(s, p - s, 0, ' ');
+		}
+
+		//--
+
+		void DLineBase::Commit()
+		{
+			if (len > 0) DPrintStrn(buf, len);
+			Clear();
+		}
+
+		void DLineBase::Commitln()
+		{
+			buf[len++] = '\n';
+			DPrintStrn(buf, len);
+			Clear();
+		}
+
+	}
+
+}
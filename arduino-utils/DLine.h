@@ -0,0 +1,143 @@
+#ifndef _SEARCHATHING_ARDUINO_UTILS_DLINE_H
+#define _SEARCHATHING_ARDUINO_UTILS_DLINE_H
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+namespace SearchAThing
+{
+
+	namespace Arduino
+	{
+
+		// Line formatter over a caller provided buffer ( see DLine ).
+		// Appends are out-of-line and shared by all line sizes; DLog and
+		// the padded DPrint integers are built on it too.
+		class DLineBase
+		{
+			char *buf;
+			uint16_t size;
+			uint16_t len = 0;
+			bool truncated = false;
+			bool flush;
+
+			// Sends the chars so far to the DPrint sink and empties the line.
+			void Flush();
+
+			// Checks that `n' chars can be appended: if they don't fit it
+			// sends the line ( flush mode ) or sets the truncated flag and
+			// returns false.
+			bool Fit(uint16_t n);
+
+			// Appends `n' chars of `s' / `n' times `c' ( in flush mode the
+			// line is sent each time it fills ).
+			void Put(const char *s, uint16_t n);
+			void PutX(char c, uint16_t n);
+
+			// Appends `n' chars of `s' left padded with `pad' up to `width'
+			// ( zero padding goes after the sign ) or nothing if they don't
+			// fit.
+			DLineBase& Padded(const char *s, uint8_t n, uint8_t width, char pad);
+
+		protected:
+			// Line over `_buf' of `_size' + 1 chars ( room for the newline
+			// appended by Commitln ).
+			DLineBase(char *_buf, uint16_t _size, bool _flush) :
+				buf(_buf), size(_size), flush(_flush) {}
+
+		public:
+			// True if some append didn't fit.
+			bool Truncated() const { return truncated; }
+
+			// Number of chars in the line.
+			uint16_t Size() const { return len; }
+
+			// Line chars ( not null terminated ).
+			const char *Data() const { return buf; }
+
+			// Empties the line.
+			void Clear()
+			{
+				len = 0;
+				truncated = false;
+			}
+
+			DLineBase& Char(char c);
+
+			// Appends `cnt' times the given char.
+			DLineBase& CharX(char c, uint16_t cnt);
+
+			// Appends `n' chars of the given string.
+			DLineBase& Strn(const char *str, uint16_t n);
+
+			DLineBase& Str(const char *str);
+
+			// Appends a flash string ( use F("str") to pass argument ).
+			DLineBase& Flash(const __FlashStringHelper *str);
+
+			// Appends numeric value (0,1) of the given boolean.
+			DLineBase& Bool(bool b);
+
+			DLineBase& Byte(byte b, uint8_t width = 0, char pad = ' ');
+
+			DLineBase& UInt16(uint16_t v, uint8_t width = 0, char pad = ' ');
+
+			DLineBase& Int16(int16_t v, uint8_t width = 0, char pad = ' ');
+
+			DLineBase& UInt32(uint32_t v, uint8_t width = 0, char pad = ' ');
+
+			DLineBase& Int32(int32_t v, uint8_t width = 0, char pad = ' ');
+
+			// Appends float with given `prec' decimals ( see FloatToString ).
+			DLineBase& Float(float v, int prec = 2);
+
+			// Appends 2 hex digits of the given byte.
+			DLineBase& Hex(byte b);
+
+			// Appends 4 hex digits of the given word ( 0x prefixed if `prefix' ).
+			DLineBase& Hex(uint16_t v, bool prefix = false);
+
+			// Appends 8 hex digits of the given long ( 0x prefixed if `prefix' ).
+			DLineBase& Hex(unsigned long v, bool prefix = false);
+
+			// Sends the line to the DPrint sink with a single write and
+			// empties it.
+			void Commit();
+
+			// Sends the line followed by a newline with a single write
+			// and empties it.
+			void Commitln();
+		};
+
+		// Line of up to `N' chars formatted on the stack and sent to the
+		// DPrint sink with a single write by Commit, eg.
+		//
+		//   DLine<32> l;
+		//   l.Flash(F("t=")).UInt32(millis()).Flash(F(" v=")).Float(v, 1);
+		//   l.Commitln();
+		//
+		// Append functions mirror DPrint ones. An append that doesn't fit
+		// is cut ( strings ) or dropped ( numbers ) and sets the truncated
+		// flag; later appends are ignored so that the line never misses
+		// pieces in the middle.
+		// With `flush' set the line is sent each time an append doesn't
+		// fit instead ( nothing is lost, more writes ).
+		template<uint16_t N>
+		class DLine : public DLineBase
+		{
+			static_assert(N > 0, "DLine size must be > 0");
+
+			char storage[N + 1];
+
+		public:
+			DLine(bool flush = false) : DLineBase(storage, N, flush) {}
+		};
+
+	}
+
+}
+
+#endif
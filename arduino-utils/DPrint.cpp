@@ -3,6 +3,19 @@
 #include "DPrint.h"
 #include "Util.h"
 
+#if DPRINT_SINK == DPRINT_SINK_UART && defined(DPRINT_TX_BUFFER)
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#endif
+
+#if DPRINT_SINK == DPRINT_SINK_SOFTSERIAL
+#include <SoftwareSerial.h>
+#endif
+
+#if DPRINT_SINK == DPRINT_SINK_HOST
+#include <stdio.h>
+#endif
+
 #ifdef DPRINT_SERIAL
 
 namespace SearchAThing
@@ -13,9 +26,25 @@ namespace Arduino
 
 bool _DPrintInitialized = false;
 
+uint8_t _DLogLevel = DLOG_LEVEL;
+uint16_t _DLogChannels = DLOG_CHANNELS;
+
+void DLogSetLevel(uint8_t level)
+{
+	_DLogLevel = level;
+}
+
+void DLogSetChannels(uint16_t channels)
+{
+	_DLogChannels = channels;
+}
+
 // if DPRINT_SERIAL is defined then all DPrint
-// functions prints on the serial the the SERIAL_SPEED 8-n-1
-#ifdef DPRINT_SERIAL
+// functions prints on the selected DPRINT_SINK
+
+#if DPRINT_SINK == DPRINT_SINK_UART
+
+// uart sink prints on the serial the the SERIAL_SPEED 8-n-1
 void _DPrintInit()
 {
 	// # refers to
@@ -40,7 +69,9 @@ void _DPrintInit()
 	UBRRL = UBRRL_VALUE;
 
 	// #24.5
-	UCSRB = (1 << RXEN) | (1 << TXEN);
+	// Enable transmitter only ( DPrint never reads; an enabled receiver
+	// keeps IdleFor out of power-down )
+	UCSRB = (1 << TXEN);
 	// Sets 8bit data mode - no parity - 1 bit stop
 	UCSRC = (1 << URSEL) | (1 << USBS) | (3 << UCSZ0);
 #else
@@ -63,42 +94,323 @@ void _DPrintInit()
 	UCSR0C = (1 << UCSZ01) | (1 << UCSZ00);
 
 	// #20.11.3
-	// Enable receiver/transmitter
-	UCSR0B = (1 << RXEN0) | (1 << TXEN0);
+	// Enable transmitter only ( DPrint never reads; an enabled receiver
+	// keeps IdleFor out of power-down )
+	UCSR0B = (1 << TXEN0);
 #endif
 
 	_DPrintInitialized = true;
 }
 
 #if defined(__AVR_ATmega8__)
-#define _DPutc(c)                           \
-	{                                       \
-		loop_until_bit_is_set(UCSRA, UDRE); \
-		UDR = c;                            \
+#define _DUCSRA UCSRA
+#define _DUCSRB UCSRB
+#define _DUDR UDR
+#define _DUDRE UDRE
+#define _DUDRIE UDRIE
+#define _DTXC TXC
+#define _DU2X U2X
+#define _DUDRE_vect USART_UDRE_vect
+#else
+#define _DUCSRA UCSR0A
+#define _DUCSRB UCSR0B
+#define _DUDR UDR0
+#define _DUDRE UDRE0
+#define _DUDRIE UDRIE0
+#define _DTXC TXC0
+#define _DU2X U2X0
+#if defined(USART0_UDRE_vect) // atmega2560 and other multi uart devices
+#define _DUDRE_vect USART0_UDRE_vect
+#else // atmega328
+#define _DUDRE_vect USART_UDRE_vect
+#endif
+#endif
+
+// set by the first char written into the uart: before that the tx
+// complete flag never sets
+static volatile bool _DTxSent = false;
+
+// Writes given char into the uart data register clearing the tx complete
+// flag so that DFlush() can detect when the last char is shifted out.
+#define _DUartTx(c)                                                \
+	{                                                              \
+		_DUCSRA = (_DUCSRA & (1 << _DU2X)) | (1 << _DTXC);         \
+		_DUDR = c;                                                 \
+		_DTxSent = true;                                           \
+	}
+
+#ifdef DPRINT_TX_BUFFER
+
+#if (DPRINT_TX_BUFFER & (DPRINT_TX_BUFFER - 1)) || DPRINT_TX_BUFFER > 256
+#error "DPRINT_TX_BUFFER must be a power of two not greater than 256"
+#endif
+
+#define _DTX_MASK (DPRINT_TX_BUFFER - 1)
+
+// tx ring buffer: `head' is moved by DPrint functions only, `tail' by the
+// udre isr only ( or by DPrint functions with interrupts disabled )
+static volatile byte _DTxBuf[DPRINT_TX_BUFFER];
+static volatile uint8_t _DTxHead = 0;
+static volatile uint8_t _DTxTail = 0;
+static volatile uint16_t _DTxDropped = 0;
+
+// Moves the oldest queued char into the uart data register.
+// Pre: uart data register empty and tx buffer not empty.
+static inline void _DTxSendOne()
+{
+	uint8_t tail = _DTxTail;
+	_DUartTx(_DTxBuf[tail]);
+	tail = (tail + 1) & _DTX_MASK;
+	_DTxTail = tail;
+	if (tail == _DTxHead)
+		_DUCSRB &= ~(1 << _DUDRIE);
+}
+
+// Drains a char by polling when interrupts are disabled ( eg. DPrint
+// called from an isr ) because the udre isr can't run.
+static inline void _DTxPoll()
+{
+	if (!(SREG & (1 << SREG_I)) && bit_is_set(_DUCSRA, _DUDRE) &&
+		_DTxTail != _DTxHead)
+		_DTxSendOne();
+}
+
+ISR(_DUDRE_vect)
+{
+	// udrie could be set back by _DTxPut while the isr was disabling it
+	if (_DTxTail == _DTxHead)
+		_DUCSRB &= ~(1 << _DUDRIE);
+	else
+		_DTxSendOne();
+}
+
+static void _DTxPut(byte c)
+{
+	uint8_t head = _DTxHead;
+	uint8_t next = (head + 1) & _DTX_MASK;
+
+	if (next == _DTxTail)
+	{
+#if DPRINT_TX_OVERFLOW == DPRINT_TX_DROP_NEWEST
+		++_DTxDropped;
+		return;
+#elif DPRINT_TX_OVERFLOW == DPRINT_TX_DROP_OLDEST
+		ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+		{
+			// isr could have freed a slot meanwhile
+			if (next == _DTxTail)
+			{
+				_DTxTail = (_DTxTail + 1) & _DTX_MASK;
+				++_DTxDropped;
+			}
+		}
+#else
+		while (next == _DTxTail)
+			_DTxPoll();
+#endif
 	}
+
+	_DTxBuf[head] = c;
+	_DTxHead = next;
+	_DUCSRB |= (1 << _DUDRIE);
+}
+
+#define _DPutc(c) _DTxPut(c)
+
 #else
-#define _DPutc(c)                             \
-	{                                         \
-		loop_until_bit_is_set(UCSR0A, UDRE0); \
-		UDR0 = c;                             \
+
+#define _DPutc(c)                                 \
+	{                                             \
+		loop_until_bit_is_set(_DUCSRA, _DUDRE);   \
+		_DUartTx(c);                              \
 	}
+
+#endif // DPRINT_TX_BUFFER
+
+void DFlush()
+{
+	if (!_DPrintInitialized)
+		return;
+
+#ifdef DPRINT_TX_BUFFER
+	while (_DTxTail != _DTxHead)
+		_DTxPoll();
+#endif
+
+	// nothing sent yet
+	if (!_DTxSent)
+		return;
+
+	// wait last char shifted out
+	loop_until_bit_is_set(_DUCSRA, _DUDRE);
+	loop_until_bit_is_set(_DUCSRA, _DTXC);
+}
+
+uint16_t DPrintTxDropped()
+{
+#ifdef DPRINT_TX_BUFFER
+	uint16_t res;
+	ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { res = _DTxDropped; }
+	return res;
+#else
+	return 0;
 #endif
+}
+
+#elif DPRINT_SINK == DPRINT_SINK_STREAM
 
-#else // DPRINT_SERIAL undef
+// stream sink prints through the Print object given by DPrintSetStream;
+// the stream is expected to be already initialized ( eg. Serial.begin )
 
-// If DPRINT_SERIAL is not enabled all DPrint functions
-// do dummy null output.
-// Note:
-// To disable calls to library DPrint simply don't define DEBUG
+static Print *_DStream = NULL;
+
+void DPrintSetStream(Print *stream)
+{
+	_DStream = stream;
+}
 
 void _DPrintInit()
 {
+	_DPrintInitialized = true;
 }
 
-#define _DPutc(c) \
-	{             \
+#define _DPutc(c)                \
+	{                            \
+		if (_DStream != NULL)    \
+			_DStream->write(c);  \
+	}
+
+#define _DPutn(buf, n)                                   \
+	{                                                    \
+		if (_DStream != NULL)                            \
+			_DStream->write((const uint8_t *)(buf), n);  \
 	}
 
+void DFlush()
+{
+	if (_DStream != NULL)
+		_DStream->flush();
+}
+
+uint16_t DPrintTxDropped()
+{
+	return 0;
+}
+
+#elif DPRINT_SINK == DPRINT_SINK_SOFTSERIAL
+
+// softserial sink prints on DPRINT_SOFTSERIAL_TX pin at SERIAL_SPEED
+
+static SoftwareSerial _DSoftSerial(DPRINT_SOFTSERIAL_RX, DPRINT_SOFTSERIAL_TX);
+
+void _DPrintInit()
+{
+	if (_DPrintInitialized)
+		return;
+
+	_DSoftSerial.begin(SERIAL_SPEED);
+
+	_DPrintInitialized = true;
+}
+
+#define _DPutc(c) _DSoftSerial.write(c)
+
+void DFlush()
+{
+	// SoftwareSerial write returns when the char was shifted out
+}
+
+uint16_t DPrintTxDropped()
+{
+	return 0;
+}
+
+#elif DPRINT_SINK == DPRINT_SINK_HOST
+
+// host sink captures printed chars into a memory buffer ( and echoes them
+// to stdout if DPRINT_HOST_STDOUT is defined ) allowing to run DPrint
+// functions on a pc
+
+static char _DHostBuf[DPRINT_HOST_BUFFER];
+static size_t _DHostLen = 0;
+static uint16_t _DHostDropped = 0;
+
+void _DPrintInit()
+{
+	_DPrintInitialized = true;
+}
+
+static void _DHostPut(char c)
+{
+#ifdef DPRINT_HOST_STDOUT
+	fputc(c, stdout);
+#endif
+	if (_DHostLen < DPRINT_HOST_BUFFER)
+		_DHostBuf[_DHostLen++] = c;
+	else
+		++_DHostDropped;
+}
+
+static void _DHostPutn(const char *buf, uint16_t n)
+{
+#ifdef DPRINT_HOST_STDOUT
+	fwrite(buf, 1, n, stdout);
+#endif
+	auto room = DPRINT_HOST_BUFFER - _DHostLen;
+	if (n > room)
+	{
+		_DHostDropped += n - room;
+		n = room;
+	}
+	memcpy(_DHostBuf + _DHostLen, buf, n);
+	_DHostLen += n;
+}
+
+#define _DPutc(c) _DHostPut(c)
+#define _DPutn(buf, n) _DHostPutn(buf, n)
+
+const char *DPrintHostCapture()
+{
+	return _DHostBuf;
+}
+
+size_t DPrintHostCaptureSize()
+{
+	return _DHostLen;
+}
+
+void DPrintHostReset()
+{
+	_DHostLen = 0;
+	_DHostDropped = 0;
+}
+
+void DFlush()
+{
+#ifdef DPRINT_HOST_STDOUT
+	fflush(stdout);
+#endif
+}
+
+uint16_t DPrintTxDropped()
+{
+	return _DHostDropped;
+}
+
+#else
+#error "unknown DPRINT_SINK"
+#endif
+
+#ifndef _DPutn
+// sinks without bulk write send given chars one by one
+static void _DPutn(const char *buf, uint16_t n)
+{
+	while (n--)
+	{
+		_DPutc(*buf);
+		++buf;
+	}
+}
 #endif
 
 void DNewline()
@@ -141,7 +453,7 @@ void DPrintCharXln(char c, uint16_t cnt)
 
 void DPrintByte(byte b)
 {
-	DPrintInt16((int)b);
+	DPrintUInt16(b);
 }
 
 void DPrintByteln(byte b)
@@ -162,61 +474,61 @@ void DPrintBoolln(bool b)
 
 //--
 
-void DPrintUInt16(uint16_t x)
+// Padded integers are formatted by a DLine sent each time it fills
+// ( width can exceed the line ).
+#define _DPRINT_INT_LINE 12
+
+void DPrintUInt16(uint16_t x, uint8_t width, char pad)
 {
-	char buf[6];
-	utoa(x, buf, 10);
-	DPrintStr(buf);
+	DLine<_DPRINT_INT_LINE> l(true);
+	l.UInt16(x, width, pad).Commit();
 }
 
-void DPrintUInt16ln(uint16_t x)
+void DPrintUInt16ln(uint16_t x, uint8_t width, char pad)
 {
-	DPrintUInt16(x);
+	DPrintUInt16(x, width, pad);
 	DNewline();
 }
 
 //--
 
-void DPrintInt16(int16_t v)
+void DPrintInt16(int16_t v, uint8_t width, char pad)
 {
-	char buf[7];
-	itoa(v, buf, 10);
-	DPrintStr(buf);
+	DLine<_DPRINT_INT_LINE> l(true);
+	l.Int16(v, width, pad).Commit();
 }
 
-void DPrintInt16ln(int16_t v)
+void DPrintInt16ln(int16_t v, uint8_t width, char pad)
 {
-	DPrintInt16(v);
+	DPrintInt16(v, width, pad);
 	DNewline();
 }
 
 //--
 
-void DPrintUInt32(uint32_t x)
+void DPrintUInt32(uint32_t x, uint8_t width, char pad)
 {
-	char buf[11];
-	ultoa(x, buf, 10);
-	DPrintStr(buf);
+	DLine<_DPRINT_INT_LINE> l(true);
+	l.UInt32(x, width, pad).Commit();
 }
 
-void DPrintUInt32ln(uint32_t x)
+void DPrintUInt32ln(uint32_t x, uint8_t width, char pad)
 {
-	DPrintUInt32(x);
+	DPrintUInt32(x, width, pad);
 	DNewline();
 }
 
 //--
 
-void DPrintInt32(int32_t v)
+void DPrintInt32(int32_t v, uint8_t width, char pad)
 {
-	char buf[12];
-	ltoa(v, buf, 10);
-	DPrintStr(buf);
+	DLine<_DPRINT_INT_LINE> l(true);
+	l.Int32(v, width, pad).Commit();
 }
 
-void DPrintInt32ln(int32_t v)
+void DPrintInt32ln(int32_t v, uint8_t width, char pad)
 {
-	DPrintInt32(v);
+	DPrintInt32(v, width, pad);
 	DNewline();
 }
 
@@ -235,7 +547,7 @@ void DPrintFloat(float v, int prec)
 
 void DPrintFloatln(float v, int prec)
 {
-	DPrintFloat(v);
+	DPrintFloat(v, prec);
 	DNewline();
 }
 
@@ -248,7 +560,7 @@ void DPrintF(const __FlashStringHelper *str)
 	auto p = (const char PROGMEM *)str;
 	auto i = 0;
 	char c;
-	while (c = pgm_read_byte(p + i))
+	while ((c = pgm_read_byte(p + i)) != 0)
 	{
 		_DPutc(c);
 		++i;
@@ -285,13 +597,7 @@ void DPrintStrln(const char *str)
 void DPrintStrn(const char *str, int size)
 {
 	_DPrintInit();
-
-	while (size)
-	{
-		_DPutc(*str);
-		++str;
-		--size;
-	}
+	_DPutn(str, size);
 }
 
 void DPrintStrnln(const char *str, int size)
@@ -326,8 +632,6 @@ void DPrintFnln(const __FlashStringHelper *str, int size)
 
 void DPrintBytes(const byte *buf, uint16_t len, char sep)
 {
-	char str[3];
-
 	while (len > 0)
 	{
 		DPrintByte(*buf);
@@ -349,11 +653,9 @@ void DPrintBytesln(const byte *buf, uint16_t len, char sep)
 
 void DPrintHex(byte b)
 {
-	char str[3];
-	itoa(b, str, HEX);
-	if (str[1] == 0)
-		DPrintChar('0');
-	DPrintStr(str);
+	char str[2];
+	ByteToHex(str, b);
+	DPrintStrn(str, 2);
 }
 
 void DPrintHexln(byte b)
@@ -366,10 +668,16 @@ void DPrintHexln(byte b)
 
 void DPrintHex(uint16_t v, bool prefix)
 {
+	char str[6];
+	auto p = str;
 	if (prefix)
-		DPrintF(F("0x"));
-	DPrintHex(highByte(v));
-	DPrintHex(lowByte(v));
+	{
+		*p++ = '0';
+		*p++ = 'x';
+	}
+	p = ByteToHex(p, highByte(v));
+	p = ByteToHex(p, lowByte(v));
+	DPrintStrn(str, p - str);
 }
 
 void DPrintHexln(uint16_t v, bool prefix)
@@ -382,12 +690,18 @@ void DPrintHexln(uint16_t v, bool prefix)
 
 void DPrintHex(unsigned long v, bool prefix)
 {
+	char str[10];
+	auto p = str;
 	if (prefix)
-		DPrintF(F("0x"));
-	DPrintHex((byte)((v >> 24) & 0xff));
-	DPrintHex((byte)((v >> 16) & 0xff));
-	DPrintHex((byte)((v >> 8) & 0xff));
-	DPrintHex((byte)(v & 0xff));
+	{
+		*p++ = '0';
+		*p++ = 'x';
+	}
+	p = ByteToHex(p, (byte)(v >> 24));
+	p = ByteToHex(p, (byte)(v >> 16));
+	p = ByteToHex(p, (byte)(v >> 8));
+	p = ByteToHex(p, (byte)v);
+	DPrintStrn(str, p - str);
 }
 
 void DPrintHexln(unsigned long v, bool prefix)
@@ -400,14 +714,24 @@ void DPrintHexln(unsigned long v, bool prefix)
 
 void DPrintHexBytes(const byte *buf, uint16_t len, char sep)
 {
+	// formats up to 16 bytes per write
+	char line[16 * 3];
+
 	while (len)
 	{
-		DPrintHex(*buf);
-		++buf;
-		--len;
+		auto p = line;
+		uint8_t n = len > 16 ? 16 : len;
+		len -= n;
 
-		if (len > 0)
-			DPrintChar(sep);
+		while (n--)
+		{
+			p = ByteToHex(p, *buf);
+			++buf;
+			if (n > 0 || len > 0)
+				*p++ = sep;
+		}
+
+		DPrintStrn(line, p - line);
 	}
 }
 
@@ -419,37 +743,81 @@ void DPrintHexBytesln(const byte *buf, uint16_t len, char sep)
 
 //--
 
-void DPrintHex(const byte *buf, uint16_t len, bool prettyPrint)
+// hex dump line: newline, address, 16 bytes, ascii gutter
+#define _DHEX_LINE_MAX (1 + 6 + 16 * 3 + 2 + 3 + 16 + 1)
+
+void DPrintHex(const byte *buf, uint16_t len, bool prettyPrint, bool ascii)
 {
+	char line[_DHEX_LINE_MAX];
 	uint16_t i = 0;
-	while (len > 0)
+
+	if (!prettyPrint)
 	{
-		if (prettyPrint && i % 16 == 0)
+		while (len)
 		{
-			if (i > 0)
-				DNewline();
-			DPrintHex(i);
-			DPrintF(F(": "));
+			auto p = line;
+			uint8_t n = len > 32 ? 32 : len;
+			len -= n;
+			while (n--)
+			{
+				p = ByteToHex(p, *buf);
+				++buf;
+			}
+			DPrintStrn(line, p - line);
+		}
+		return;
+	}
+
+	while (len)
+	{
+		auto p = line;
+		uint8_t n = len > 16 ? 16 : len;
+		len -= n;
+
+		if (i > 0)
+			*p++ = '\n';
+		p = ByteToHex(p, highByte(i));
+		p = ByteToHex(p, lowByte(i));
+		*p++ = ':';
+		*p++ = ' ';
+
+		for (uint8_t j = 0; j < n; ++j)
+		{
+			*p++ = ' ';
+			if (j % 8 == 0)
+				*p++ = ' ';
+			p = ByteToHex(p, buf[j]);
 		}
 
-		if (prettyPrint)
+		if (ascii)
 		{
-			DPrintChar(' ');
-			if (i % 8 == 0)
-				DPrintChar(' ');
+			// aligns gutter of last partial line
+			for (uint8_t j = n; j < 16; ++j)
+			{
+				*p++ = ' ';
+				*p++ = ' ';
+				*p++ = ' ';
+				if (j % 8 == 0)
+					*p++ = ' ';
+			}
+			*p++ = ' ';
+			*p++ = ' ';
+			*p++ = '|';
+			for (uint8_t j = 0; j < n; ++j)
+				*p++ = (buf[j] >= 0x20 && buf[j] < 0x7f) ? buf[j] : '.';
+			*p++ = '|';
 		}
 
-		DPrintHex(*buf);
+		DPrintStrn(line, p - line);
 
-		++i;
-		++buf;
-		--len;
+		i += n;
+		buf += n;
 	}
 }
 
-void DPrintHexln(const byte *buf, uint16_t len, bool prettyPrint)
+void DPrintHexln(const byte *buf, uint16_t len, bool prettyPrint, bool ascii)
 {
-	DPrintHex(buf, len, prettyPrint);
+	DPrintHex(buf, len, prettyPrint, ascii);
 	DNewline();
 }
 
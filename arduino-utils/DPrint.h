@@ -8,8 +8,9 @@
 #endif
 
 #include "DebugMacros.h"
+#include "DLine.h"
 
-#ifdef DPRINT_SERIAL
+#if defined(DPRINT_SERIAL) && DPRINT_SINK == DPRINT_SINK_UART
 #define BAUD SERIAL_SPEED
 
 #if !defined(__AVR_ATmega8__)
@@ -32,6 +33,63 @@ extern bool _DPrintInitialized;
 // called automatically when DPrint functions are used.
 void _DPrintInit();
 
+// Waits until all printed chars are transmitted.
+// If DPRINT_TX_BUFFER is defined it drains the tx ring buffer too.
+void DFlush();
+
+// Returns the number of chars discarded because the tx ring buffer
+// was full ( DPRINT_TX_DROP_NEWEST or DPRINT_TX_DROP_OLDEST policy )
+// or because the host capture buffer was full.
+uint16_t DPrintTxDropped();
+
+#if DPRINT_SINK == DPRINT_SINK_STREAM
+// Sets the Print object ( eg. &Serial ) used as output by the
+// DPRINT_SINK_STREAM sink. Nothing is printed until a stream is set.
+void DPrintSetStream(Print *stream);
+#endif
+
+#if DPRINT_SINK == DPRINT_SINK_HOST
+// Retrieve chars captured by the DPRINT_SINK_HOST sink
+// ( not null terminated ).
+const char *DPrintHostCapture();
+
+// Number of chars captured by the DPRINT_SINK_HOST sink.
+size_t DPrintHostCaptureSize();
+
+// Discards chars captured by the DPRINT_SINK_HOST sink.
+void DPrintHostReset();
+#endif
+
+//===========================================================================
+// LOG LEVELS AND CHANNELS
+//---------------------------------------------------------------------------
+// Statements guarded by DLOG_IF(level, channels) are compiled out when the
+// level is below DLOG_LEVEL or channels are out of DLOG_CHANNELS mask;
+// those compiled in are filtered at runtime through DLogSetLevel and
+// DLogSetChannels. eg.
+//
+//   DLOG_IF(DLOG_WARN, DLOG_CH_USER) { DPrintFln(F("low battery")); }
+//===========================================================================
+
+extern uint8_t _DLogLevel;
+extern uint16_t _DLogChannels;
+
+// Sets runtime minimum log level ( defaults to DLOG_LEVEL ).
+void DLogSetLevel(uint8_t level);
+
+// Sets runtime mask of enabled log channels ( defaults to DLOG_CHANNELS ).
+void DLogSetChannels(uint16_t channels);
+
+#define DLOG_COMPILED(level, ch) \
+    ((level) >= DLOG_LEVEL && ((ch)&DLOG_CHANNELS) != 0)
+
+#define DLOG_ON(level, ch)                                  \
+    (DLOG_COMPILED(level, ch) && (level) >= _DLogLevel &&   \
+     ((ch)&_DLogChannels) != 0)
+
+// ( empty then branch so that a following else can't bind to it )
+#define DLOG_IF(level, ch) if (!DLOG_ON(level, ch)) {} else
+
 // Prints a newline.
 void DNewline();
 
@@ -67,32 +125,40 @@ void DPrintBool(bool b);
 void DPrintBoolln(bool b);
 
 // Prints numeric value of the given unsigned 16bit integer.
-void DPrintUInt16(uint16_t x);
+// If `width' is given the value is right aligned to `width' chars
+// padding with `pad' char ( with '0' pad the sign precedes padding ).
+void DPrintUInt16(uint16_t x, uint8_t width = 0, char pad = ' ');
 
 // Prints numeric value of the given unsigned 16bit integer.
 // Follows a newline.
-void DPrintUInt16ln(uint16_t x);
+void DPrintUInt16ln(uint16_t x, uint8_t width = 0, char pad = ' ');
 
 // Prints numeric value of the given signed 16bit integer.
-void DPrintInt16(int16_t v);
+// If `width' is given the value is right aligned to `width' chars
+// padding with `pad' char ( with '0' pad the sign precedes padding ).
+void DPrintInt16(int16_t v, uint8_t width = 0, char pad = ' ');
 
 // Prints numeric value of the given signed 16bit integer.
 // Follows a newline.
-void DPrintInt16ln(int16_t v);
+void DPrintInt16ln(int16_t v, uint8_t width = 0, char pad = ' ');
 
 // Prints numeric value of the given unsigned 32bit integer.
-void DPrintUInt32(uint32_t x);
+// If `width' is given the value is right aligned to `width' chars
+// padding with `pad' char ( with '0' pad the sign precedes padding ).
+void DPrintUInt32(uint32_t x, uint8_t width = 0, char pad = ' ');
 
 // Prints numeric value of the given unsigned 32bit integer.
 // Follows a newline.
-void DPrintUInt32ln(uint32_t x);
+void DPrintUInt32ln(uint32_t x, uint8_t width = 0, char pad = ' ');
 
 // Prints numeric value of the given signed 32bit integer.
-void DPrintInt32(int32_t v);
+// If `width' is given the value is right aligned to `width' chars
+// padding with `pad' char ( with '0' pad the sign precedes padding ).
+void DPrintInt32(int32_t v, uint8_t width = 0, char pad = ' ');
 
 // Prints numeric value of the given signed 32bit integer.
 // Follows a newline.
-void DPrintInt32ln(int32_t v);
+void DPrintInt32ln(int32_t v, uint8_t width = 0, char pad = ' ');
 
 #define DPrintULong DPrintUInt32
 #define DPrintULongln DPrintUInt32ln
@@ -188,13 +254,92 @@ void DPrintHexBytesln(const byte *buf, uint16_t len, char sep = '-');
 // Prints lowercase hexdecimal value of `len' bytes of the given
 // buffer in sequence (if `prettyPrint'==false) or in two column 8+8
 // space separated and addressed (when `prettyPrint'==true).
-void DPrintHex(const byte *buf, uint16_t len, bool prettyPrint = false);
+// If `ascii' is set pretty print lines ends with printable chars
+// gutter like `hexdump -C'.
+void DPrintHex(const byte *buf, uint16_t len, bool prettyPrint = false,
+               bool ascii = false);
 
 // Prints lowercase hexdecimal value of `len' bytes of the given
 // buffer in sequence (if `prettyPrint'==false) or in two column 8+8
 // space separated and addressed (when `prettyPrint'==true).
+// If `ascii' is set pretty print lines ends with printable chars
+// gutter like `hexdump -C'.
 // Follows a newline.
-void DPrintHexln(const byte *buf, uint16_t len, bool prettyPrint = false);
+void DPrintHexln(const byte *buf, uint16_t len, bool prettyPrint = false,
+                 bool ascii = false);
+
+//===========================================================================
+// VARIADIC LOG
+//---------------------------------------------------------------------------
+// DLog prints all given arguments in sequence with a single call at the
+// call site dispatching each one by type at compile time. eg.
+//
+//   DLogln(F("free blk="), blk, F(" frg="), frg);
+//
+// Supported arguments: flash strings, strings, char, bool, integers
+// ( printed in decimal ) and floats ( printed with 2 decimals ).
+//===========================================================================
+
+inline void _DLogArg(DLineBase &l, const __FlashStringHelper *s) { l.Flash(s); }
+inline void _DLogArg(DLineBase &l, const char *s) { l.Str(s); }
+inline void _DLogArg(DLineBase &l, char c) { l.Char(c); }
+inline void _DLogArg(DLineBase &l, bool b) { l.Bool(b); }
+inline void _DLogArg(DLineBase &l, signed char v) { l.Int16(v); }
+inline void _DLogArg(DLineBase &l, unsigned char v) { l.UInt16(v); }
+inline void _DLogArg(DLineBase &l, short v) { l.Int16(v); }
+inline void _DLogArg(DLineBase &l, unsigned short v) { l.UInt16(v); }
+
+inline void _DLogArg(DLineBase &l, int v)
+{
+    if (sizeof(int) == 2)
+        l.Int16(v);
+    else
+        l.Int32(v);
+}
+
+inline void _DLogArg(DLineBase &l, unsigned int v)
+{
+    if (sizeof(int) == 2)
+        l.UInt16(v);
+    else
+        l.UInt32(v);
+}
+
+inline void _DLogArg(DLineBase &l, long v) { l.Int32(v); }
+inline void _DLogArg(DLineBase &l, unsigned long v) { l.UInt32(v); }
+inline void _DLogArg(DLineBase &l, float v) { l.Float(v); }
+inline void _DLogArg(DLineBase &l, double v) { l.Float(v); }
+
+inline void _DLogArgs(DLineBase &l) {}
+
+template <class T, class... Args>
+inline void _DLogArgs(DLineBase &l, T first, Args... rest)
+{
+    _DLogArg(l, first);
+    _DLogArgs(l, rest...);
+}
+
+// Prints given arguments in sequence.
+// Arguments are formatted into a DLOG_LINE_SIZE DLine sent with a single
+// write ( in chunks if longer ). Each distinct argument type list
+// instantiates one out-of-line function shared by all call sites using it.
+template <class... Args>
+__attribute__((noinline)) void DLog(Args... args)
+{
+    DLine<DLOG_LINE_SIZE> l(true);
+    _DLogArgs(l, args...);
+    l.Commit();
+}
+
+// Prints given arguments in sequence.
+// Follows a newline.
+template <class... Args>
+__attribute__((noinline)) void DLogln(Args... args)
+{
+    DLine<DLOG_LINE_SIZE> l(true);
+    _DLogArgs(l, args...);
+    l.Commitln();
+}
 
 class DPrintCls : public Print
 {
@@ -204,6 +349,7 @@ class DPrintCls : public Print
 #ifdef DPRINT_SERIAL
         DPrintChar(c);
 #endif
+        return 1;
     }
 };
 
@@ -213,6 +359,16 @@ class DPrintCls : public Print
 
 #ifndef DPRINT_SERIAL
 
+#undef DLOG_ON
+#define DLOG_ON(level, ch) (0)
+#define DLogSetLevel(x) ;
+#define DLogSetChannels(x) ;
+#define DLog(...) ;
+#define DLogln(...) ;
+#define DFlush() ;
+#define DPrintTxDropped() 0
+#define DPrintSetStream(x) ;
+#define DPrintHostReset() ;
 #define DNewline() ;
 #define DPrintln() ;
 #define DPrintChar(x, ...) ;
@@ -0,0 +1,146 @@
+#include "DebugMacros.h"
+
+#include "DPrintTok.h"
+#include "Util.h"
+
+#ifdef DPRINT_SERIAL
+
+namespace SearchAThing
+{
+
+namespace Arduino
+{
+
+// Sends a token record with given tag and `len' bytes of argument
+// already written msb first into `arg'.
+static void _DPrintTok(const __FlashStringHelper *str, byte tag,
+					   const byte *arg, uint8_t len)
+{
+	byte rec[8];
+
+	rec[0] = DTOK_SYNC;
+	BufWrite16(rec + 1, (uint16_t)(size_t)str);
+	rec[3] = tag;
+	if (len > 0)
+		memcpy(rec + 4, arg, len);
+
+	DPrintStrn((const char *)rec, 4 + len);
+}
+
+static void _DPrintTok16(const __FlashStringHelper *str, byte tag, uint16_t v)
+{
+	byte arg[2];
+	BufWrite16(arg, v);
+	_DPrintTok(str, tag, arg, 2);
+}
+
+static void _DPrintTok32(const __FlashStringHelper *str, byte tag, uint32_t v)
+{
+	byte arg[4];
+	BufWrite32(arg, v);
+	_DPrintTok(str, tag, arg, 4);
+}
+
+static void _DPrintTokFloat(const __FlashStringHelper *str, byte tag,
+							float v, int prec)
+{
+	uint32_t bits;
+	memcpy(&bits, &v, 4);
+
+	if (prec < 0)
+		prec = 0;
+	else if (prec > 7)
+		prec = 7;
+
+	_DPrintTok32(str, tag | DTOK_FLOAT | (prec << DTOK_PREC_SHIFT), bits);
+}
+
+//--
+
+void DPrintTok(const __FlashStringHelper *str)
+{
+	_DPrintTok(str, DTOK_NONE, NULL, 0);
+}
+
+void DPrintTokln(const __FlashStringHelper *str)
+{
+	_DPrintTok(str, DTOK_NONE | DTOK_NEWLINE, NULL, 0);
+}
+
+//--
+
+void DPrintTok(const __FlashStringHelper *str, byte v)
+{
+	_DPrintTok(str, DTOK_U8, &v, 1);
+}
+
+void DPrintTokln(const __FlashStringHelper *str, byte v)
+{
+	_DPrintTok(str, DTOK_U8 | DTOK_NEWLINE, &v, 1);
+}
+
+//--
+
+void DPrintTok(const __FlashStringHelper *str, uint16_t v)
+{
+	_DPrintTok16(str, DTOK_U16, v);
+}
+
+void DPrintTokln(const __FlashStringHelper *str, uint16_t v)
+{
+	_DPrintTok16(str, DTOK_U16 | DTOK_NEWLINE, v);
+}
+
+//--
+
+void DPrintTok(const __FlashStringHelper *str, int16_t v)
+{
+	_DPrintTok16(str, DTOK_I16, (uint16_t)v);
+}
+
+void DPrintTokln(const __FlashStringHelper *str, int16_t v)
+{
+	_DPrintTok16(str, DTOK_I16 | DTOK_NEWLINE, (uint16_t)v);
+}
+
+//--
+
+void DPrintTok(const __FlashStringHelper *str, uint32_t v)
+{
+	_DPrintTok32(str, DTOK_U32, v);
+}
+
+void DPrintTokln(const __FlashStringHelper *str, uint32_t v)
+{
+	_DPrintTok32(str, DTOK_U32 | DTOK_NEWLINE, v);
+}
+
+//--
+
+void DPrintTok(const __FlashStringHelper *str, int32_t v)
+{
+	_DPrintTok32(str, DTOK_I32, (uint32_t)v);
+}
+
+void DPrintTokln(const __FlashStringHelper *str, int32_t v)
+{
+	_DPrintTok32(str, DTOK_I32 | DTOK_NEWLINE, (uint32_t)v);
+}
+
+//--
+
+void DPrintTok(const __FlashStringHelper *str, float v, int prec)
+{
+	_DPrintTokFloat(str, 0, v, prec);
+}
+
+void DPrintTokln(const __FlashStringHelper *str, float v, int prec)
+{
+	_DPrintTokFloat(str, DTOK_NEWLINE, v, prec);
+}
+
+} // namespace Arduino
+
+} // namespace SearchAThing
+
+#endif // DPRINT_SERIAL
@@ -0,0 +1,85 @@
+#ifndef _SEARCHATHING_ARDUINO_UTILS_DPRINT_TOK_H
+#define _SEARCHATHING_ARDUINO_UTILS_DPRINT_TOK_H
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include "DebugMacros.h"
+
+//===========================================================================
+// DEFERRED ( TOKEN ) LOGGING
+//---------------------------------------------------------------------------
+// Instead of formatting text on the device the DPrintTok functions sends
+// a binary record made of the flash address of the given F("str") and the
+// raw argument bytes. The host tool `tools/dtokdecode' rebuilds the text
+// reading strings from the sketch elf.
+//
+// record layout ( multibyte fields msb first ):
+//
+//   DTOK_SYNC | str addr (16bit) | tag | argument bytes
+//
+// tag bits 0..3 argument type ( DTOK_xxx ), bits 4..6 float precision,
+// bit 7 newline follows.
+// Chars outside records are plain DPrint text.
+//===========================================================================
+
+#define DTOK_SYNC 0x1e
+
+#define DTOK_NONE 0  // no argument
+#define DTOK_U8 1    // 1 byte
+#define DTOK_U16 2   // 2 bytes
+#define DTOK_U32 3   // 4 bytes
+#define DTOK_I16 4   // 2 bytes
+#define DTOK_I32 5   // 4 bytes
+#define DTOK_FLOAT 6 // 4 bytes ieee754 single
+
+#define DTOK_TYPE_MASK 0x0f
+#define DTOK_PREC_SHIFT 4
+#define DTOK_PREC_MASK 0x70
+#define DTOK_NEWLINE 0x80
+
+namespace SearchAThing
+{
+
+namespace Arduino
+{
+
+// Sends token of the given flash string.
+// Note: Use F("str") to pass argument.
+void DPrintTok(const __FlashStringHelper *str);
+
+// Sends token of the given flash string followed by a newline.
+void DPrintTokln(const __FlashStringHelper *str);
+
+// Sends token of the given flash string followed by given value.
+void DPrintTok(const __FlashStringHelper *str, byte v);
+void DPrintTok(const __FlashStringHelper *str, uint16_t v);
+void DPrintTok(const __FlashStringHelper *str, int16_t v);
+void DPrintTok(const __FlashStringHelper *str, uint32_t v);
+void DPrintTok(const __FlashStringHelper *str, int32_t v);
+void DPrintTok(const __FlashStringHelper *str, float v, int prec = 2);
+
+// Sends token of the given flash string followed by given value.
+// Follows a newline.
+void DPrintTokln(const __FlashStringHelper *str, byte v);
+void DPrintTokln(const __FlashStringHelper *str, uint16_t v);
+void DPrintTokln(const __FlashStringHelper *str, int16_t v);
+void DPrintTokln(const __FlashStringHelper *str, uint32_t v);
+void DPrintTokln(const __FlashStringHelper *str, int32_t v);
+void DPrintTokln(const __FlashStringHelper *str, float v, int prec = 2);
+
+} // namespace Arduino
+
+} // namespace SearchAThing
+
+#ifndef DPRINT_SERIAL
+
+#define DPrintTok(x, ...) ;
+#define DPrintTokln(x, ...) ;
+
+#endif
+
+#endif
@@ -0,0 +1,96 @@
+#include "DebugMacros.h"
+#include "DPrint.h"
+
+#include "DProfile.h"
+#include "Util.h"
+
+#ifdef DPROFILE
+
+namespace SearchAThing
+{
+
+	namespace Arduino
+	{
+
+		DProfileSlot _DProfileSlots[DPROFILE_SLOTS];
+
+		__attribute__((noinline)) void _DProfileEnd(uint8_t id, DProfileTick now)
+		{
+			DProfileSlot& s = _DProfileSlots[id];
+
+			// unsigned difference holds across clock wrap
+			DProfileTick dt = now - s.start;
+
+			if (s.count == 0 || dt < s.min) s.min = dt;
+			if (dt > s.max) s.max = dt;
+			s.total += dt;
+			++s.count;
+		}
+
+		void DProfileReset()
+		{
+#ifdef DPROFILE_TIMER1
+			// normal mode, no prescaler
+			TCCR1A = 0;
+			TCCR1B = (1 << CS10);
+#endif
+			memset(_DProfileSlots, 0, sizeof(_DProfileSlots));
+		}
+
+		void DProfilePrint()
+		{
+			for (uint8_t i = 0; i < DPROFILE_SLOTS; ++i)
+			{
+				const DProfileSlot& s = _DProfileSlots[i];
+				if (s.count == 0) continue;
+
+				DLogln(F("prof "), i, F(" n="), s.count, F(" tot="), s.total,
+					F(" min="), s.min, F(" max="), s.max, F(" avg="), s.total / s.count);
+			}
+		}
+
+		uint16_t DProfileExport(byte *buf, uint16_t size)
+		{
+			uint16_t len = 0;
+
+			for (uint8_t i = 0; i < DPROFILE_SLOTS; ++i)
+			{
+				const DProfileSlot& s = _DProfileSlots[i];
+				if (s.count == 0) continue;
+				if (size - len < DPROFILE_RECORD_SIZE) break;
+
+				byte *p = buf + len;
+				p[0] = i;
+				BufWrite32(p + 1, s.count);
+				BufWrite32(p + 5, s.total);
+				BufWrite32(p + 9, s.min);
+				BufWrite32(p + 13, s.max);
+
+				len += DPROFILE_RECORD_SIZE;
+			}
+
+			return len;
+		}
+
+		DProfileTick DProfileCalibrate()
+		{
+			DProfileSlot saved = _DProfileSlots[0];
+			memset(&_DProfileSlots[0], 0, sizeof(DProfileSlot));
+
+			for (uint8_t i = 0; i < 16; ++i)
+			{
+				DPROFILE_BEGIN(0);
+				DPROFILE_END(0);
+			}
+
+			DProfileTick res = _DProfileSlots[0].min;
+			_DProfileSlots[0] = saved;
+
+			return res;
+		}
+
+	}
+
+}
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef _SEARCHATHING_ARDUINO_UTILS_DPROFILE_H
+#define _SEARCHATHING_ARDUINO_UTILS_DPROFILE_H
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include "DebugMacros.h"
+
+// Size of each DProfileExport record.
+#define DPROFILE_RECORD_SIZE 17
+
+#ifdef DPROFILE
+
+namespace SearchAThing
+{
+
+	namespace Arduino
+	{
+
+#ifdef DPROFILE_TIMER1
+		// timer1 count ( cpu cycles, wraps each 65536 )
+		typedef uint16_t DProfileTick;
+#define _DPROFILE_NOW() TCNT1
+#else
+		// micros() ( 4us resolution at 16MHz )
+		typedef unsigned long DProfileTick;
+#define _DPROFILE_NOW() micros()
+#endif
+
+		// Probe statistics ( times in ticks ).
+		struct DProfileSlot
+		{
+			// time of the last DPROFILE_BEGIN
+			DProfileTick start;
+
+			// number of DPROFILE_END
+			uint32_t count;
+
+			// sum of begin..end times
+			uint32_t total;
+
+			DProfileTick min;
+			DProfileTick max;
+		};
+
+		extern DProfileSlot _DProfileSlots[DPROFILE_SLOTS];
+
+		// Accounts a begin..end interval of the given probe.
+		void _DProfileEnd(uint8_t id, DProfileTick now);
+
+		// Clears all probes statistics.
+		// With DPROFILE_TIMER1 it starts timer1 at cpu clock too thus it
+		// must be called once ( eg. from setup ) before using probes.
+		void DProfileReset();
+
+		// Prints statistics of probes used at least once
+		// ( ticks are us or cpu cycles with DPROFILE_TIMER1 ).
+		void DProfilePrint();
+
+		// Writes probes statistics into given `buf' of `size' bytes as
+		// DPROFILE_RECORD_SIZE bytes records ( only probes used at least
+		// once, as many as fit ) and returns bytes written.
+		// Record: id(1) count(4) total(4) min(4) max(4), msb first.
+		uint16_t DProfileExport(byte *buf, uint16_t size);
+
+		// Measures ticks spent by an empty DPROFILE_BEGIN / DPROFILE_END
+		// pair ( min over some runs ) to be subtracted from probe times.
+		// Statistics of probe 0 are preserved.
+		DProfileTick DProfileCalibrate();
+
+	}
+
+}
+
+// Starts timing probe `id' ( 0 .. DPROFILE_SLOTS-1 ).
+#define DPROFILE_BEGIN(id) (SearchAThing::Arduino::_DProfileSlots[id].start = _DPROFILE_NOW())
+
+// Ends timing probe `id' accounting the elapsed time since its BEGIN.
+#define DPROFILE_END(id) SearchAThing::Arduino::_DProfileEnd(id, _DPROFILE_NOW())
+
+#else
+
+#define DPROFILE_BEGIN(id)
+#define DPROFILE_END(id)
+#define DProfileReset() ;
+#define DProfilePrint() ;
+#define DProfileExport(buf, size) 0
+#define DProfileCalibrate() 0
+
+#endif
+
+#endif
@@ -9,6 +9,75 @@
 // comment follow to disable serial debug
 //#define SEARCHATHING_DISABLE
 
+// output sink used by DPrint functions
+// ( DPRINT_SINK_UART, DPRINT_SINK_STREAM, DPRINT_SINK_SOFTSERIAL,
+//   DPRINT_SINK_HOST ) ; defaults to uart on avr and host elsewhere
+//#define DPRINT_SINK	DPRINT_SINK_UART
+
+// pins used by DPRINT_SINK_SOFTSERIAL
+#define DPRINT_SOFTSERIAL_RX	10
+#define DPRINT_SOFTSERIAL_TX	11
+
+// size of the capture buffer used by DPRINT_SINK_HOST
+#define DPRINT_HOST_BUFFER	4096
+
+// uncomment follow to enable interrupt driven uart tx through a ring
+// buffer of given size ( power of two, max 256 ) instead of busy-wait
+// the uart for each char
+//#define DPRINT_TX_BUFFER	64
+
+// policy applied when uart tx buffer is full
+// ( DPRINT_TX_BLOCK, DPRINT_TX_DROP_NEWEST, DPRINT_TX_DROP_OLDEST )
+#define DPRINT_TX_OVERFLOW	DPRINT_TX_BLOCK
+
+// uncomment follow to count allocations of SList using default allocator
+// into SAllocTrace<0>::Stats()
+//#define SLIST_ALLOC_TRACE
+
+// uncomment follow to compile FreeMemoryMaxBlockBisect ( finds the
+// largest malloc by trying allocations ) to cross-check FreeMemoryMaxBlock
+//#define FREE_MEMORY_MAX_BISECT
+
+// uncomment follow to paint free ram with RAM_STATS_CANARY at startup
+// ( an .init1 routine ) so that RAMStatsSample reports the stack high
+// water mark
+//#define RAM_STATS_PAINT
+
+// uncomment follow to enable DPROFILE_BEGIN / DPROFILE_END probes
+// ( they expand to nothing otherwise )
+//#define DPROFILE
+
+// number of probe ids ( 0 .. DPROFILE_SLOTS-1 )
+#define DPROFILE_SLOTS	8
+
+// uncomment follow to time probes in cpu cycles through timer1 ( not
+// available to the sketch anymore ) instead of micros()
+//#define DPROFILE_TIMER1
+
+// minimum log level compiled in for DLOG_IF statements
+// ( DLOG_TRACE, DLOG_DEBUG, DLOG_INFO, DLOG_WARN, DLOG_ERROR, DLOG_NONE )
+#ifndef DLOG_LEVEL
+#define DLOG_LEVEL	DLOG_DEBUG
+#endif
+
+// mask of log channels compiled in for DLOG_IF statements
+#ifndef DLOG_CHANNELS
+#define DLOG_CHANNELS	0xffff
+#endif
+
+// stack buffer where DLog / DLogln format a line before sending it with
+// a single write ( longer lines are sent in chunks of this size )
+#ifndef DLOG_LINE_SIZE
+#define DLOG_LINE_SIZE	48
+#endif
+
+// longest interval slept by a single IdleFor call ( longer ones, eg.
+// SSCHEDULER_IDLE when no task is scheduled, are clamped so that the
+// caller runs again at least this often )
+#ifndef IDLE_MAX_MS
+#define IDLE_MAX_MS	8000UL
+#endif
+
 //--------------------------------------------------
 
 #if defined(ARDUINO) && ARDUINO >= 100
@@ -17,6 +86,36 @@
 #include "WProgram.h"
 #endif
 
+#define DPRINT_SINK_UART		0	// avr hardware uart registers
+#define DPRINT_SINK_STREAM		1	// arduino Print object ( eg. Serial )
+#define DPRINT_SINK_SOFTSERIAL	2	// SoftwareSerial tx pin
+#define DPRINT_SINK_HOST		3	// memory capture ( and stdout ) on pc
+
+#ifndef DPRINT_SINK
+#if defined(__AVR__)
+#define DPRINT_SINK DPRINT_SINK_UART
+#else
+#define DPRINT_SINK DPRINT_SINK_HOST
+#endif
+#endif
+
+#define DPRINT_TX_BLOCK			0	// wait for the isr to free a slot
+#define DPRINT_TX_DROP_NEWEST	1	// discard the char being printed
+#define DPRINT_TX_DROP_OLDEST	2	// discard the oldest queued char
+
+#define DLOG_TRACE	0
+#define DLOG_DEBUG	1
+#define DLOG_INFO	2
+#define DLOG_WARN	3
+#define DLOG_ERROR	4
+#define DLOG_NONE	5
+
+// library log channels; user channels starts from DLOG_CH_USER bit
+#define DLOG_CH_MEM		0x0001	// Util memory functions
+#define DLOG_CH_SLIST	0x0002	// SList
+#define DLOG_CH_SCHED	0x0004	// SScheduler
+#define DLOG_CH_USER	0x0100
+
 //===========================================================================
 // USER OVERRIDABLE MACROS
 //---------------------------------------------------------------------------
@@ -0,0 +1,191 @@
+#include "DebugMacros.h"
+#include "DPrint.h"
+
+#include "Idle.h"
+
+// watchdog interrupt mode isn't available on all avr ( eg. atmega8 );
+// the host shim stubs sleep and watchdog registers
+#if defined(WDTCSR) && defined(WDIE)
+#define _IDLE_POWER_DOWN
+#endif
+
+#if defined(__AVR__) || defined(_IDLE_POWER_DOWN)
+#include <avr/sleep.h>
+#endif
+
+#ifdef _IDLE_POWER_DOWN
+#include <avr/wdt.h>
+#include <util/atomic.h>
+
+// arduino core ( wiring.c ) millis counter
+extern volatile unsigned long timer0_millis;
+#endif
+
+#ifdef _IDLE_POWER_DOWN
+
+#define _IDLE_WDT_STEPS 10
+
+// nominal watchdog timeouts ( ms ) indexed by prescaler value
+static const uint16_t _IdleWdtMs[_IDLE_WDT_STEPS] PROGMEM = {
+	16, 32, 64, 125, 250, 500, 1000, 2000, 4000, 8000 };
+
+static volatile bool _IdleWdtFired;
+
+ISR(WDT_vect)
+{
+	wdt_disable();
+	_IdleWdtFired = true;
+}
+
+// True if no peripheral stopped by power-down is in use: uart receiver
+// enabled ( Serial.begin, DPrint uart sink ), pwm outputs connected
+// ( analogWrite ) or timer1 / timer2 interrupts enabled ( tone, Servo ).
+// Timer0 isn't checked since power-down accounts millis() itself.
+static bool _IdlePowerDownSafe()
+{
+#if defined(UCSR0B) && defined(RXEN0)
+	if (UCSR0B & (1 << RXEN0)) return false;
+#endif
+#if defined(TCCR0A) && defined(COM0A1)
+	if (TCCR0A & ((1 << COM0A1) | (1 << COM0B1))) return false;
+#endif
+#if defined(TCCR1A) && defined(COM1A1)
+	if (TCCR1A & ((1 << COM1A1) | (1 << COM1B1))) return false;
+#endif
+#if defined(TCCR2A) && defined(COM2A1)
+	if (TCCR2A & ((1 << COM2A1) | (1 << COM2B1))) return false;
+#endif
+#if defined(TIMSK1)
+	if (TIMSK1) return false;
+#endif
+#if defined(TIMSK2)
+	if (TIMSK2) return false;
+#endif
+	return true;
+}
+
+// Enters power-down until the watchdog fires after the timeout of the
+// given `prescaler' ( or until another interrupt wakes the cpu ).
+static void _IdleWdtSleep(uint8_t prescaler)
+{
+	uint8_t wdtcsr = (1 << WDIE) | (prescaler & 7) | ((prescaler & 8) ? (1 << WDP3) : 0);
+
+	_IdleWdtFired = false;
+	set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+
+	cli();
+	wdt_reset();
+	MCUSR &= ~(1 << WDRF);
+	// timed sequence: prescaler must be written within 4 cycles
+	WDTCSR = (1 << WDCE) | (1 << WDE);
+	WDTCSR = wdtcsr;
+	sleep_enable();
+	// the instruction following sei is executed before any pending
+	// interrupt thus the wake up can't be missed
+	sei();
+	sleep_cpu();
+	sleep_disable();
+
+	// woken by another interrupt
+	if (!_IdleWdtFired) wdt_disable();
+}
+
+#endif
+
+namespace SearchAThing
+{
+
+	namespace Arduino
+	{
+
+		static IdleStats _idleStats;
+
+		// millis() when the last IdleFor returned
+		static unsigned long _idleAwakeStart = 0;
+
+		unsigned long IdleFor(unsigned long ms, bool deep)
+		{
+			_idleStats.awake += millis() - _idleAwakeStart;
+
+			if (ms > IDLE_MAX_MS) ms = IDLE_MAX_MS;
+
+			DFlush();
+
+			unsigned long slept = 0;
+			bool interrupted = false;
+
+#ifdef _IDLE_POWER_DOWN
+			if (deep && _IdlePowerDownSafe())
+			{
+				uint8_t p = _IDLE_WDT_STEPS - 1;
+				while (ms - slept >= pgm_read_word(&_IdleWdtMs[0]))
+				{
+					// longest step not exceeding the time left
+					while (pgm_read_word(&_IdleWdtMs[p]) > ms - slept) --p;
+
+					_IdleWdtSleep(p);
+					if (!_IdleWdtFired)
+					{
+						interrupted = true;
+						break;
+					}
+
+					uint16_t step = pgm_read_word(&_IdleWdtMs[p]);
+					ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+					{
+						timer0_millis += step;
+					}
+					slept += step;
+				}
+			}
+#else
+			(void)deep;
+#endif
+
+			if (!interrupted && ms > slept)
+			{
+				// timer0 keeps running in idle mode thus millis() stays
+				// correct by itself
+				unsigned long start = millis();
+#if defined(__AVR__)
+				set_sleep_mode(SLEEP_MODE_IDLE);
+				while (millis() - start < ms - slept) sleep_mode();
+#else
+				delay(ms - slept);
+#endif
+				slept += millis() - start;
+			}
+
+			_idleStats.slept += slept;
+			_idleAwakeStart = millis();
+
+			return slept;
+		}
+
+		const IdleStats& IdleGetStats()
+		{
+			return _idleStats;
+		}
+
+		void IdleStatsReset()
+		{
+			_idleStats.awake = 0;
+			_idleStats.slept = 0;
+			_idleAwakeStart = millis();
+		}
+
+		uint8_t IdleDutyCycle()
+		{
+			unsigned long total = _idleStats.awake + _idleStats.slept;
+			if (total == 0) return 100;
+
+			// avoid awake * 100 overflow on long runs
+			unsigned long res = total < 100 ?
+				_idleStats.awake * 100 / total : _idleStats.awake / (total / 100);
+
+			return res > 100 ? 100 : res;
+		}
+
+	}
+
+}
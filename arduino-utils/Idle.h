@@ -0,0 +1,60 @@
+#ifndef _SEARCHATHING_ARDUINO_UTILS_IDLE_H
+#define _SEARCHATHING_ARDUINO_UTILS_IDLE_H
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include "DebugMacros.h"
+
+namespace SearchAThing
+{
+
+	namespace Arduino
+	{
+
+		// Awake and slept time ( ms ) accumulated by IdleFor calls.
+		struct IdleStats
+		{
+			// time spent outside IdleFor
+			unsigned long awake;
+
+			// time spent sleeping inside IdleFor
+			unsigned long slept;
+		};
+
+		// Sleeps about `ms' milliseconds ( eg. the time until the next
+		// deadline as returned by SScheduler::Run, at most IDLE_MAX_MS )
+		// then returns the time actually slept.
+		// Pending DPrint output is flushed first.
+		// If `deep' and power-down is safe the longest part of the interval
+		// is slept in power-down mode woken by the watchdog ( steps of
+		// 16ms..8s, watchdog oscillator accuracy is about 10% ) adding
+		// slept time to millis() since timer0 is stopped; the remainder
+		// ( or all the interval otherwise ) is slept in idle mode woken by
+		// timer0 each ms.
+		// Power-down stops timers, pwm and uart receive thus it's skipped
+		// if the uart receiver is enabled, a pwm output is connected or
+		// timer1 / timer2 interrupts are enabled; pass `deep' false to
+		// never use it ( eg. for peripherals not checked ). A wake up by
+		// another interrupt ( eg. pin change ) during power-down ends the
+		// sleep early and that partial step isn't accounted.
+		// The watchdog isr is defined here thus the sketch can't use it.
+		unsigned long IdleFor(unsigned long ms, bool deep = true);
+
+		// Awake / slept time accumulated since startup or IdleStatsReset.
+		const IdleStats& IdleGetStats();
+
+		// Restarts awake / slept accounting.
+		void IdleStatsReset();
+
+		// 0..100 percentage of time spent awake.
+		uint8_t IdleDutyCycle();
+
+	}
+
+}
+
+#endif
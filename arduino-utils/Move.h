@@ -0,0 +1,43 @@
+#ifndef _SEARCHATHING_ARDUINO_UTILS_MOVE_H
+#define _SEARCHATHING_ARDUINO_UTILS_MOVE_H
+
+// Minimal std::move / std::forward replacement given that avr-libc doesn't
+// provide the <utility> header.
+
+namespace SearchAThing
+{
+
+	namespace Arduino
+	{
+
+		template<class T> struct SRemoveReference { typedef T type; };
+		template<class T> struct SRemoveReference<T&> { typedef T type; };
+		template<class T> struct SRemoveReference<T&&> { typedef T type; };
+
+		// Casts given object to an rvalue so that it can be moved from
+		// ( same as std::move ).
+		template<class T>
+		constexpr typename SRemoveReference<T>::type&& SMove(T&& t)
+		{
+			return static_cast<typename SRemoveReference<T>::type&&>(t);
+		}
+
+		// Forwards given argument preserving its value category
+		// ( same as std::forward ).
+		template<class T>
+		constexpr T&& SForward(typename SRemoveReference<T>::type& t)
+		{
+			return static_cast<T&&>(t);
+		}
+
+		template<class T>
+		constexpr T&& SForward(typename SRemoveReference<T>::type&& t)
+		{
+			return static_cast<T&&>(t);
+		}
+
+	}
+
+}
+
+#endif
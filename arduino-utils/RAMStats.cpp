@@ -0,0 +1,157 @@
+#include "DebugMacros.h"
+#include "DPrint.h"
+
+//===========================================================================
+// info about data,bss,heap,stack in
+// #include <stdlib.h>
+//---------------------------------------------------------------------------
+struct __freelist
+{
+	size_t sz;
+	struct __freelist *nx;
+};
+
+extern char *__brkval;
+extern struct __freelist *__flp;
+extern size_t __malloc_margin;
+extern char *__malloc_heap_start;
+extern char *__malloc_heap_end;
+//---------------------------------------------------------------------------
+
+#include "RAMStats.h"
+#include "DCbor.h"
+
+#if defined(__AVR__) && defined(RAM_STATS_PAINT)
+// Paints free ram ( from the end of .bss up to the initial stack ) with
+// RAM_STATS_CANARY before main runs. Placed in .init1 it runs before the
+// stack pointer and r1 are set up thus it uses neither.
+void _RAMStatsPaint(void) __attribute__((naked, used, section(".init1")));
+void _RAMStatsPaint(void)
+{
+	__asm volatile(
+		"	ldi r30, lo8(_end)\n"
+		"	ldi r31, hi8(_end)\n"
+		"	ldi r24, %0\n"
+		"	ldi r25, hi8(__stack)\n"
+		"	rjmp 2f\n"
+		"1:	st Z+, r24\n"
+		"2:	cpi r30, lo8(__stack)\n"
+		"	cpc r31, r25\n"
+		"	brlo 1b\n"
+		"	breq 1b\n"
+		:: "M"(RAM_STATS_CANARY));
+}
+#endif
+
+namespace SearchAThing
+{
+
+	namespace Arduino
+	{
+
+		// highest heap top seen by RAMStatsSample
+		static char *_heapTopHighWater = NULL;
+
+		void RAMStatsSample(RAMStats& stats)
+		{
+			char *heapTop = __brkval != 0 ? __brkval : __malloc_heap_start;
+			if (heapTop > _heapTopHighWater) _heapTopHighWater = heapTop;
+
+			stats.heapSize = heapTop - __malloc_heap_start;
+			stats.heapHighWater = _heapTopHighWater - __malloc_heap_start;
+
+			// free list
+
+			stats.freeListCount = 0;
+			stats.freeListSum = 0;
+			stats.freeListMax = 0;
+			for (struct __freelist *fp = __flp; fp != NULL; fp = fp->nx)
+			{
+				++stats.freeListCount;
+				stats.freeListSum += fp->sz;
+				if (fp->sz > stats.freeListMax) stats.freeListMax = fp->sz;
+			}
+
+			char *limit = __malloc_heap_end != 0 ?
+				__malloc_heap_end : (char *)(SP - __malloc_margin);
+
+			stats.heapTopFree = 0;
+			if (limit > heapTop + sizeof(size_t))
+				stats.heapTopFree = limit - heapTop - sizeof(size_t);
+
+			stats.freeMax = stats.freeListMax > stats.heapTopFree ?
+				stats.freeListMax : stats.heapTopFree;
+
+			uint16_t freeSum = stats.freeListSum + stats.heapTopFree;
+			stats.fragmentation = freeSum == 0 ? 0 :
+				100 - (uint8_t)((uint32_t)stats.freeMax * 100 / freeSum);
+
+			// stack
+
+			stats.stackSize = RAMEND - SP;
+
+#if defined(__AVR__) && defined(RAM_STATS_PAINT)
+			// scan down from SP for a run of canary bytes: dead frames
+			// above it may hold canary valued bytes while the heap below
+			// it may have grown and shrunk since the last sample
+			byte *p = (byte *)SP;
+			uint8_t run = 0;
+			while (p > (byte *)heapTop && run < RAM_STATS_CANARY_RUN)
+			{
+				run = *(volatile byte *)p == RAM_STATS_CANARY ? run + 1 : 0;
+				--p;
+			}
+
+			if (run < RAM_STATS_CANARY_RUN)
+			{
+				// stack reached the heap
+				stats.neverUsed = 0;
+				stats.stackHighWater = RAMEND - (uint16_t)heapTop;
+			}
+			else
+			{
+				// lowest address ever reached by the stack is above the run
+				byte *low = p + RAM_STATS_CANARY_RUN + 1;
+				while (p > (byte *)heapTop && *(volatile byte *)p == RAM_STATS_CANARY) --p;
+
+				stats.neverUsed = low - p - 1;
+				stats.stackHighWater = RAMEND - (uint16_t)low + 1;
+			}
+#else
+			// no painted ram to scan ( not enabled or host shim )
+			stats.neverUsed = 0;
+			stats.stackHighWater = stats.stackSize;
+#endif
+		}
+
+		void PrintRAMStats(const RAMStats& stats)
+		{
+			DLogln(F("heap size="), stats.heapSize, F(" hw="), stats.heapHighWater);
+			DLogln(F("free list cnt="), stats.freeListCount,
+				F(" sum="), stats.freeListSum, F(" max="), stats.freeListMax);
+			DLogln(F("free top="), stats.heapTopFree, F(" max="), stats.freeMax,
+				F(" frag="), stats.fragmentation, '%');
+			DLogln(F("stack size="), stats.stackSize, F(" hw="), stats.stackHighWater,
+				F(" never used="), stats.neverUsed);
+		}
+
+		void PrintRAMStatsCbor(const RAMStats& stats)
+		{
+			// keys documented in RAMStats.h
+			DCborMap(11);
+			DCborKeyUInt(0, stats.heapSize);
+			DCborKeyUInt(1, stats.heapHighWater);
+			DCborKeyUInt(2, stats.freeListCount);
+			DCborKeyUInt(3, stats.freeListSum);
+			DCborKeyUInt(4, stats.freeListMax);
+			DCborKeyUInt(5, stats.heapTopFree);
+			DCborKeyUInt(6, stats.freeMax);
+			DCborKeyUInt(7, stats.fragmentation);
+			DCborKeyUInt(8, stats.stackSize);
+			DCborKeyUInt(9, stats.stackHighWater);
+			DCborKeyUInt(10, stats.neverUsed);
+		}
+
+	}
+
+}
@@ -0,0 +1,90 @@
+#ifndef _SEARCHATHING_ARDUINO_UTILS_RAMSTATS_H
+#define _SEARCHATHING_ARDUINO_UTILS_RAMSTATS_H
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include "DebugMacros.h"
+
+// Byte painted over free ram at startup to detect stack high water mark
+// ( see RAM_STATS_PAINT ).
+#define RAM_STATS_CANARY 0xc5
+
+// Consecutive canary bytes that mark never used ram ( a single one could
+// be a stale stack value ).
+#define RAM_STATS_CANARY_RUN 8
+
+namespace SearchAThing
+{
+
+	namespace Arduino
+	{
+
+		// Heap and stack telemetry.
+		// All sizes are in bytes.
+		struct RAMStats
+		{
+			// heap size ( from heap start to heap top )
+			uint16_t heapSize;
+
+			// max heap size observed by RAMStatsSample calls
+			uint16_t heapHighWater;
+
+			// number of chunks in the malloc free list
+			uint16_t freeListCount;
+
+			// total bytes of the free list chunks
+			uint16_t freeListSum;
+
+			// largest free list chunk
+			uint16_t freeListMax;
+
+			// room from heap top to the malloc limit
+			uint16_t heapTopFree;
+
+			// max contiguous block allocatable
+			// ( largest between `freeListMax' and `heapTopFree' )
+			uint16_t freeMax;
+
+			// 0..100 percentage of free memory not usable by a single
+			// allocation of `freeMax' bytes
+			uint8_t fragmentation;
+
+			// current stack size ( from RAMEND to SP )
+			uint16_t stackSize;
+
+			// max stack size reached since startup
+			// ( current stack size unless RAM_STATS_PAINT )
+			uint16_t stackHighWater;
+
+			// bytes never touched between heap top and stack high water
+			// ( 0 unless RAM_STATS_PAINT )
+			uint16_t neverUsed;
+		};
+
+		// Fills given `stats' with current heap and stack telemetry.
+		// With RAM_STATS_PAINT the stack high water mark is found scanning
+		// down from SP for the canary painted at startup over the free ram;
+		// it doesn't allocate memory.
+		void RAMStatsSample(RAMStats& stats);
+
+		// Prints given `stats'.
+		void PrintRAMStats(const RAMStats& stats);
+
+		// Writes given `stats' as a CBOR map ( see DCbor.h ) with integer
+		// keys:
+		//
+		//   0 heapSize       4 freeListMax    8 stackSize
+		//   1 heapHighWater  5 heapTopFree    9 stackHighWater
+		//   2 freeListCount  6 freeMax       10 neverUsed
+		//   3 freeListSum    7 fragmentation
+		void PrintRAMStatsCbor(const RAMStats& stats);
+
+	}
+
+}
+
+#endif
@@ -8,6 +8,10 @@
 #endif
 
 #include "DebugMacros.h"
+#include "Move.h"
+#include "AllocTrace.h"
+
+#include <new.h> // placement new
 
 namespace SearchAThing
 {
@@ -17,15 +21,15 @@ namespace SearchAThing
 		
 		// Templated simple linked-list node element.
 		// Store templated element `T' into a node object that allow to
-		// follow using a `next' pointer to the next one in the list.		
-		// The given template `T' must support default constructor for
-		// internal purpose.
+		// follow using a `next' pointer to the next one in the list.
 		template<class T>
 		class SListNode
 		{
 		public:
-			// Constructor stores a copy of given element into internal data.
-			SListNode<T>(const T& _data) { data = _data; }
+			// Constructor builds internal data in place forwarding given
+			// arguments to the `T' constructor.
+			template<class... Args>
+			SListNode(Args&&... args) : data(SForward<Args>(args)...) {}
 
 			// Element data.
 			T data;
@@ -34,42 +38,241 @@ namespace SearchAThing
 			SListNode<T> *next = NULL;
 		};
 
+		// Forward iterator over SList elements
+		// ( allows `for (auto &x : list)' loops ).
+		template<class T>
+		class SListIterator
+		{
+			SListNode<T> *node;
+
+		public:
+			SListIterator(SListNode<T> *_node) : node(_node) {}
+
+			T& operator * () const { return node->data; }
+
+			T *operator -> () const { return &node->data; }
+
+			SListIterator& operator ++ ()
+			{
+				node = node->next;
+				return *this;
+			}
+
+			SListIterator operator ++ (int)
+			{
+				SListIterator res = *this;
+				node = node->next;
+				return res;
+			}
+
+			bool operator == (const SListIterator& other) const { return node == other.node; }
+
+			bool operator != (const SListIterator& other) const { return node != other.node; }
+		};
+
+		// Default SList node allocator.
+		// Nodes are allocated on the heap.
+		template<class T>
+		class SListHeapAllocator
+		{
+		public:
+			// Allocates uninitialized memory for a node.
+			// Returns NULL if out of memory.
+			static void *Allocate() { return malloc(sizeof(SListNode<T>)); }
+
+			// Deallocates memory of a node previously allocated.
+			static void Deallocate(void *p) { free(p); }
+		};
+
+		// SList node allocator that counts allocations of the wrapped
+		// allocator `A' into SAllocTrace<Tag>::Stats().
+		// eg. SList<int, SListTracedAllocator<int, SListHeapAllocator<int>, 3>>
+		template<class T, class A = SListHeapAllocator<T>, uint8_t Tag = 0>
+		class SListTracedAllocator
+		{
+		public:
+			static void *Allocate()
+			{
+				void *res = A::Allocate();
+
+				if (res != NULL)
+					SAllocTrace<Tag>::Stats().OnAlloc(sizeof(SListNode<T>));
+				else
+					SAllocTrace<Tag>::Stats().OnFailure();
+
+				return res;
+			}
+
+			static void Deallocate(void *p)
+			{
+				A::Deallocate(p);
+				SAllocTrace<Tag>::Stats().OnFree(sizeof(SListNode<T>));
+			}
+		};
+
+		// Allocator used by SList when not specified: heap, traced on
+		// SAllocTrace<0> if SLIST_ALLOC_TRACE is defined.
+#ifdef SLIST_ALLOC_TRACE
+		template<class T>
+		using SListDefaultAllocator = SListTracedAllocator<T>;
+#else
+		template<class T>
+		using SListDefaultAllocator = SListHeapAllocator<T>;
+#endif
+
+		// Fixed capacity SList node allocator.
+		// Nodes are taken from a static array of `N' slots shared by all
+		// lists using the same allocator type ( use distinct `Tag' to get
+		// separate pools for the same `T' and `N' ). Freed slots are linked
+		// into an intrusive free list so that allocation and deallocation
+		// are O(1) without malloc overhead nor heap fragmentation.
+		template<class T, uint16_t N, uint8_t Tag = 0>
+		class SListPool
+		{
+			union Slot
+			{
+				Slot *next;
+				alignas(SListNode<T>) byte node[sizeof(SListNode<T>)];
+			};
+
+			static Slot slots[N];
+			// free list of released slots
+			static Slot *freeSlots;
+			// slots never allocated starts from this index
+			static uint16_t unused;
+			// slots currently allocated
+			static uint16_t inUse;
+
+		public:
+			// Allocates uninitialized memory for a node.
+			// Returns NULL if the pool is exhausted.
+			static void *Allocate()
+			{
+				Slot *slot;
+
+				if (freeSlots != NULL)
+				{
+					slot = freeSlots;
+					freeSlots = slot->next;
+				}
+				else if (unused < N)
+					slot = &slots[unused++];
+				else
+					return NULL;
+
+				++inUse;
+				return slot;
+			}
+
+			// Gives back to the pool memory of a node previously allocated.
+			static void Deallocate(void *p)
+			{
+				Slot *slot = (Slot *)p;
+				slot->next = freeSlots;
+				freeSlots = slot;
+				--inUse;
+			}
+
+			// Max number of nodes the pool can hold.
+			static uint16_t Capacity() { return N; }
+
+			// Number of nodes that can be still allocated.
+			static uint16_t Available() { return N - inUse; }
+		};
+
+		template<class T, uint16_t N, uint8_t Tag>
+		typename SListPool<T, N, Tag>::Slot SListPool<T, N, Tag>::slots[N];
+
+		template<class T, uint16_t N, uint8_t Tag>
+		typename SListPool<T, N, Tag>::Slot *SListPool<T, N, Tag>::freeSlots = NULL;
+
+		template<class T, uint16_t N, uint8_t Tag>
+		uint16_t SListPool<T, N, Tag>::unused = 0;
+
+		template<class T, uint16_t N, uint8_t Tag>
+		uint16_t SListPool<T, N, Tag>::inUse = 0;
+
 		// Templated simple linked-list.
 		// Store templated element `T' into a simple linked list.
-		// The given template `T' must support default constructor for
-		// internal purpose.
-		template<class T>
+		// Nodes memory is managed by the allocator `A' ( heap by default,
+		// eg. SList<int, SListPool<int, 16>> for a fixed capacity pool ).
+		template<class T, class A = SListDefaultAllocator<T>>
 		class SList
 		{
 			uint16_t size = 0;
 			SListNode<T> *first = NULL;
 			SListNode<T> *last = NULL;
 
+			// last node accessed by GetNode so that sequential access
+			// continues from there instead of walking again from `first'
+			mutable uint16_t cursorIdx = 0;
+			mutable SListNode<T> *cursorNode = NULL;
+
+			// Destroys the node data and gives back its memory.
+			static void DeleteNode(SListNode<T> *node)
+			{
+				node->~SListNode<T>();
+				A::Deallocate(node);
+			}
+
 		public:
 			// Default constructor.
 			SList()
 			{
 			}
 
-			// Copy constructor.
+			// Copy constructor ( the list is empty if out of memory, see
+			// assign operator ).
 			SList(const SList& other)
 			{
 				*this = other;
 			}
 
+			// Move constructor. Takes the nodes of the given `other' list
+			// leaving it empty.
+			SList(SList&& other)
+			{
+				*this = SMove(other);
+			}
+
 			// Assign operator. Creates a copy of the given `other' list.
+			// The copy is built before releasing current nodes thus if it
+			// runs out of memory the list is left unchanged ( Size()
+			// differs from the `other' one ); with a pool allocator room
+			// for both lists is needed meanwhile.
 			SList& operator = (const SList& other)
 			{
-				Clear();
+				if (this == &other) return *this;
+
+				SList copy;
 
 				auto node = other.first;
 
 				while (node)
 				{
-					Add(node->data);
+					if (copy.Add(node->data) == NULL) return *this;
 					node = node->next;
 				}
 
+				return *this = SMove(copy);
+			}
+
+			// Move assign operator. Takes the nodes of the given `other' list
+			// leaving it empty.
+			SList& operator = (SList&& other)
+			{
+				if (this == &other) return *this;
+
+				Clear();
+
+				size = other.size;
+				first = other.first;
+				last = other.last;
+
+				other.size = 0;
+				other.first = other.last = NULL;
+				other.cursorNode = NULL;
+
 				return *this;
 			}
 
@@ -83,18 +286,38 @@ namespace SearchAThing
 			// Current list size.
 			uint16_t Size() const { return size; }
 
-			// Adds given templated object `data' to the list.
-			// If DEBUG and DEBUG_ASSERT are enabled a report about out-of-
-			// memory will be reported if unable to allocate more nodes.
-			T& Add(const T& data)
+			// Adds a copy of given templated object `data' to the list.
+			// Returns pointer to the stored object or NULL if out of memory.
+			T *Add(const T& data)
 			{
-				auto node = new SListNode<T>(data);
-				if (node == NULL)
+				return Emplace(data);
+			}
+
+			// Moves given templated object `data' into the list.
+			// Returns pointer to the stored object or NULL if out of memory.
+			T *Add(T&& data)
+			{
+				return Emplace(SMove(data));
+			}
+
+			// Adds to the list a templated object constructed in place with
+			// given arguments.
+			// Returns pointer to the stored object or NULL if out of memory;
+			// in that case an error on DLOG_CH_SLIST channel is reported too.
+			template<class... Args>
+			T *Emplace(Args&&... args)
+			{
+				void *mem = A::Allocate();
+				if (mem == NULL)
 				{
-#if defined DEBUG && defined DEBUG_ASSERT	
-					DPrint(F("* Fatal: SList alloc of node out of memory"));
-#endif
+					DLOG_IF(DLOG_ERROR, DLOG_CH_SLIST)
+					{
+						DPrintFln(F("* Fatal: SList alloc of node out of memory"));
+					}
+					return NULL;
 				}
+
+				auto node = new (mem) SListNode<T>(SForward<Args>(args)...);
 				if (first == NULL)
 					first = last = node;
 				else
@@ -104,7 +327,7 @@ namespace SearchAThing
 				}
 				++size;
 
-				return node->data;
+				return &node->data;
 			}
 
 			// Clear the list destroying each nodes thus calling the
@@ -117,11 +340,12 @@ namespace SearchAThing
 				while (node != NULL)
 				{
 					SListNode<T> *tmp = node->next;
-					delete node;
+					DeleteNode(node);
 					node = tmp;
 					--size;
 				}
 				first = last = NULL;
+				cursorNode = NULL;
 			}
 
 			// Remove the node by idx ( 0 is the first ).
@@ -133,7 +357,7 @@ namespace SearchAThing
 				if (idx == 0) // delete first
 				{
 					SListNode<T> *tmp = first->next;
-					delete first;
+					DeleteNode(first);
 					first = tmp;
 				}
 				else
@@ -141,18 +365,21 @@ namespace SearchAThing
 					SListNode<T> *before = GetNode(idx - 1);
 					if (idx == size - 1) // delete last
 					{
-						delete last;
+						DeleteNode(last);
 						before->next = NULL;
 						last = before;
 					}
 					else
 					{
 						SListNode<T> *after = before->next->next;
-						delete before->next;
+						DeleteNode(before->next);
 						before->next = after;
 					}
 				}
 
+				// nodes before `idx' are unchanged
+				if (cursorIdx >= idx) cursorNode = NULL;
+
 				--size;
 			}
 
@@ -166,18 +393,41 @@ namespace SearchAThing
 
 			// Retrieve a pointer to the node at the given `idx'
 			// ( 0 is start ). If an invalid index was given returns NULL.
+			// The walk starts from the last accessed node when `idx' is
+			// beyond it, thus sequential access is O(1) amortized.
 			SListNode<T> *GetNode(int idx) const
 			{
 				if (idx == size - 1) return last;
 
-				if (idx >= size) return NULL;
+				if (idx < 0 || idx >= size) return NULL;
 
 				SListNode<T> *res = first;
-				while (idx--) { res = res->next; }
+				int i = 0;
+
+				if (cursorNode != NULL && idx >= cursorIdx)
+				{
+					res = cursorNode;
+					i = cursorIdx;
+				}
+
+				while (i < idx)
+				{
+					res = res->next;
+					++i;
+				}
+
+				cursorIdx = idx;
+				cursorNode = res;
 
 				return res;
 			}
 
+			// Iterator to the first element.
+			SListIterator<T> begin() const { return SListIterator<T>(first); }
+
+			// Iterator past the last element.
+			SListIterator<T> end() const { return SListIterator<T>(NULL); }
+
 		};
 
 	}
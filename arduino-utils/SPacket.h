@@ -0,0 +1,177 @@
+#ifndef _SEARCHATHING_ARDUINO_UTILS_SPACKET_H
+#define _SEARCHATHING_ARDUINO_UTILS_SPACKET_H
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include "DebugMacros.h"
+#include "ByteStream.h"
+
+// Declares a big endian field of `Class::member' ( to be used as
+// SPacket template argument ).
+#define SFIELD(Class, member) \
+	SearchAThing::Arduino::SField<Class, decltype(Class::member), &Class::member, true>
+
+// Declares a little endian field of `Class::member'.
+#define SFIELD_LE(Class, member) \
+	SearchAThing::Arduino::SField<Class, decltype(Class::member), &Class::member, false>
+
+namespace SearchAThing
+{
+
+	namespace Arduino
+	{
+
+		//===========================================================================
+		// WIRE TYPES
+		//---------------------------------------------------------------------------
+		// Maps a field type to the unsigned integer stored on the wire.
+		//===========================================================================
+
+		template<class T>
+		struct SWire
+		{
+			typedef T Bits;
+			static Bits ToBits(T v) { return v; }
+			static T FromBits(Bits b) { return b; }
+		};
+
+		template<class T, class U>
+		struct SWireSigned
+		{
+			typedef U Bits;
+			static Bits ToBits(T v) { return (U)v; }
+			static T FromBits(Bits b) { return (T)b; }
+		};
+
+		template<> struct SWire<int8_t> : SWireSigned<int8_t, uint8_t> {};
+		template<> struct SWire<int16_t> : SWireSigned<int16_t, uint16_t> {};
+		template<> struct SWire<int32_t> : SWireSigned<int32_t, uint32_t> {};
+		template<> struct SWire<int64_t> : SWireSigned<int64_t, uint64_t> {};
+
+		template<>
+		struct SWire<bool>
+		{
+			typedef uint8_t Bits;
+			static Bits ToBits(bool v) { return v ? 1 : 0; }
+			static bool FromBits(Bits b) { return b != 0; }
+		};
+
+		template<>
+		struct SWire<float>
+		{
+			typedef uint32_t Bits;
+			static Bits ToBits(float v) { return FloatBits(v); }
+			static float FromBits(Bits b) { return BitsFloat(b); }
+		};
+
+		//===========================================================================
+		// FIELD
+		//===========================================================================
+
+		// Packet field bound to member `M' of type `T' of class `C' stored
+		// big endian if `BigEndian' or little endian otherwise.
+		// Declare through SFIELD / SFIELD_LE macros.
+		template<class C, class T, T C::*M, bool BigEndian>
+		struct SField
+		{
+			typedef SWire<T> Wire;
+
+			static constexpr uint16_t WireSize = sizeof(typename Wire::Bits);
+
+			static void Store(byte *p, const C& c)
+			{
+				if (BigEndian)
+					SBytes<WireSize>::StoreBE(p, Wire::ToBits(c.*M));
+				else
+					SBytes<WireSize>::StoreLE(p, Wire::ToBits(c.*M));
+			}
+
+			static void Load(const byte *p, C& c)
+			{
+				typedef typename Wire::Bits Bits;
+
+				if (BigEndian)
+					c.*M = Wire::FromBits(SBytes<WireSize>::template LoadBE<Bits>(p));
+				else
+					c.*M = Wire::FromBits(SBytes<WireSize>::template LoadLE<Bits>(p));
+			}
+		};
+
+		//===========================================================================
+		// PACKET
+		//---------------------------------------------------------------------------
+		// Schema declared once as a list of fields, eg.
+		//
+		//   struct Msg { uint16_t id; int32_t temp; float v; };
+		//   typedef SPacket<SFIELD(Msg, id), SFIELD(Msg, temp), SFIELD(Msg, v)> MsgPacket;
+		//
+		//   byte buf[MsgPacket::WireSize];
+		//   MsgPacket::Encode(buf, msg);
+		//
+		// fields are laid out in declaration order without padding; each
+		// field is written at a compile time offset so that encode and
+		// decode inline to a sequence of byte moves ( no runtime tables ).
+		//===========================================================================
+
+		template<class... Fields>
+		struct SPacket;
+
+		template<>
+		struct SPacket<>
+		{
+			static constexpr uint16_t WireSize = 0;
+
+			template<class C> static void Encode(byte *, const C&) {}
+			template<class C> static void Decode(const byte *, C&) {}
+		};
+
+		template<class F, class... Rest>
+		struct SPacket<F, Rest...>
+		{
+			// Encoded size in bytes.
+			static constexpr uint16_t WireSize = F::WireSize + SPacket<Rest...>::WireSize;
+
+			// Writes `WireSize' bytes encoding of `c' into `p'.
+			template<class C>
+			static void Encode(byte *p, const C& c)
+			{
+				F::Store(p, c);
+				SPacket<Rest...>::Encode(p + F::WireSize, c);
+			}
+
+			// Reads `WireSize' bytes from `p' into `c' fields.
+			template<class C>
+			static void Decode(const byte *p, C& c)
+			{
+				F::Load(p, c);
+				SPacket<Rest...>::Decode(p + F::WireSize, c);
+			}
+
+			// Encodes `c' at the writer cursor ( latches writer error if
+			// there isn't room ).
+			template<class C>
+			static void Write(ByteWriter& w, const C& c)
+			{
+				byte *p = w.Reserve(WireSize);
+				if (p != NULL) Encode(p, c);
+			}
+
+			// Decodes `c' from the reader cursor ( latches reader error and
+			// leaves `c' untouched if there aren't enough bytes ).
+			template<class C>
+			static void Read(ByteReader& r, C& c)
+			{
+				const byte *p = r.Consume(WireSize);
+				if (p != NULL) Decode(p, c);
+			}
+		};
+
+	}
+
+}
+
+#endif
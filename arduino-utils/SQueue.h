@@ -0,0 +1,135 @@
+#ifndef _SEARCHATHING_ARDUINO_UTILS_SQUEUE_H
+#define _SEARCHATHING_ARDUINO_UTILS_SQUEUE_H
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include "DebugMacros.h"
+
+namespace SearchAThing
+{
+
+	namespace Arduino
+	{
+
+#if defined(__AVR__)
+		// Index type of SQueue. A single byte is read and written by one
+		// instruction on avr so an index update can't be seen half done by
+		// an isr ( a 16bit one would be stored into two steps ).
+		typedef uint8_t SQueueIndex;
+#define SQUEUE_MAX_SIZE 128
+#else
+		typedef uint16_t SQueueIndex;
+#define SQUEUE_MAX_SIZE 32768
+#endif
+
+		// Templated single producer / single consumer fifo queue of `N'
+		// ( power of two ) elements safe to use between an isr and loop()
+		// without disabling interrupts nor allocating memory.
+		// The producer only writes `head', the consumer only writes `tail';
+		// each side publishes its index after the element copy so the other
+		// side never sees a slot not yet written or not yet read.
+		// The templated `T' should be a plain data struct because it is
+		// copied into and out of the queue.
+		template<class T, uint16_t N>
+		class SQueue
+		{
+			static_assert(N > 0 && (N & (N - 1)) == 0 && N <= SQUEUE_MAX_SIZE,
+				"SQueue size must be a power of two not greater than SQUEUE_MAX_SIZE");
+
+			T items[N];
+
+			// free running counters: slot is counter & (N - 1)
+			SQueueIndex head = 0; // next push ( producer side )
+			SQueueIndex tail = 0; // next pop ( consumer side )
+
+			static SQueueIndex LoadAcquire(const SQueueIndex& idx)
+			{
+#if defined(__AVR__)
+				SQueueIndex res = *(const volatile SQueueIndex *)&idx;
+				asm volatile("" ::: "memory");
+				return res;
+#else
+				return __atomic_load_n(&idx, __ATOMIC_ACQUIRE);
+#endif
+			}
+
+			static void StoreRelease(SQueueIndex& idx, SQueueIndex v)
+			{
+#if defined(__AVR__)
+				asm volatile("" ::: "memory");
+				*(volatile SQueueIndex *)&idx = v;
+#else
+				__atomic_store_n(&idx, v, __ATOMIC_RELEASE);
+#endif
+			}
+
+		public:
+			// Max number of elements.
+			uint16_t Capacity() const { return N; }
+
+			// Current number of elements ( a snapshot when called while the
+			// other side is running ).
+			uint16_t Size() const
+			{
+				return (SQueueIndex)(LoadAcquire(head) - LoadAcquire(tail));
+			}
+
+			// True if there are no elements to pop.
+			bool Empty() const { return Size() == 0; }
+
+			// True if no more elements can be pushed.
+			bool Full() const { return Size() == N; }
+
+			// Copies given element into the queue ( producer side ).
+			// Returns false if the queue is full.
+			bool Push(const T& data)
+			{
+				SQueueIndex h = head;
+
+				if ((SQueueIndex)(h - LoadAcquire(tail)) == N) return false;
+
+				items[h & (N - 1)] = data;
+				StoreRelease(head, h + 1);
+
+				return true;
+			}
+
+			// Copies the oldest element into `data' removing it from the queue
+			// ( consumer side ).
+			// Returns false if the queue is empty.
+			bool Pop(T& data)
+			{
+				SQueueIndex t = tail;
+
+				if (LoadAcquire(head) == t) return false;
+
+				data = items[t & (N - 1)];
+				StoreRelease(tail, t + 1);
+
+				return true;
+			}
+
+			// Copies the oldest element into `data' without removing it
+			// ( consumer side ).
+			// Returns false if the queue is empty.
+			bool Peek(T& data) const
+			{
+				SQueueIndex t = tail;
+
+				if (LoadAcquire(head) == t) return false;
+
+				data = items[t & (N - 1)];
+
+				return true;
+			}
+		};
+
+	}
+
+}
+
+#endif
@@ -0,0 +1,181 @@
+#ifndef _SEARCHATHING_ARDUINO_UTILS_SRING_H
+#define _SEARCHATHING_ARDUINO_UTILS_SRING_H
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include "DebugMacros.h"
+#include "Move.h"
+
+#include <new.h> // placement new
+
+namespace SearchAThing
+{
+
+	namespace Arduino
+	{
+
+		// Templated fixed capacity ring buffer ( fifo ).
+		// Store up to `N' ( power of two ) templated elements `T' inside the
+		// object itself ( no heap allocation ). When `Overwrite' is true
+		// pushing into a full ring discards the oldest element instead of
+		// failing.
+		// Exposes the same Size/Get/Remove/Clear surface of SList where
+		// index 0 is the oldest element.
+		// Note: not safe between isr and loop(), see SQueue for that.
+		template<class T, uint16_t N, bool Overwrite = false>
+		class SRing
+		{
+			static_assert(N > 0 && (N & (N - 1)) == 0 && N <= 32768,
+				"SRing size must be a power of two not greater than 32768");
+
+			// free running counters: slot is counter & (N - 1)
+			uint16_t head = 0; // next push
+			uint16_t tail = 0; // oldest element
+			alignas(T) byte storage[N * sizeof(T)];
+
+			T *At(uint16_t counter) { return (T *)storage + (counter & (N - 1)); }
+			const T *At(uint16_t counter) const { return (const T *)storage + (counter & (N - 1)); }
+
+		public:
+			// Default constructor.
+			SRing()
+			{
+			}
+
+			// Copy constructor.
+			SRing(const SRing& other)
+			{
+				*this = other;
+			}
+
+			// Assign operator. Creates a copy of the given `other' ring.
+			SRing& operator = (const SRing& other)
+			{
+				if (this == &other) return *this;
+
+				Clear();
+				for (uint16_t i = 0; i < other.Size(); ++i) Push(other.Get(i));
+
+				return *this;
+			}
+
+			// Destructor. Calls destructor of stored templated objects.
+			~SRing()
+			{
+				Clear();
+			}
+
+			// Current number of elements.
+			uint16_t Size() const { return head - tail; }
+
+			// Max number of elements.
+			uint16_t Capacity() const { return N; }
+
+			// True if there are no elements.
+			bool Empty() const { return head == tail; }
+
+			// True if the ring holds `N' elements.
+			bool Full() const { return Size() == N; }
+
+			// Pushes a copy of given templated object `data'.
+			// Returns pointer to the stored object or NULL if full
+			// ( and not in overwrite mode ).
+			T *Push(const T& data)
+			{
+				return Emplace(data);
+			}
+
+			// Moves given templated object `data' into the ring.
+			// Returns pointer to the stored object or NULL if full
+			// ( and not in overwrite mode ).
+			T *Push(T&& data)
+			{
+				return Emplace(SMove(data));
+			}
+
+			// Pushes a templated object constructed in place with given
+			// arguments.
+			// Returns pointer to the stored object or NULL if full
+			// ( and not in overwrite mode ).
+			template<class... Args>
+			T *Emplace(Args&&... args)
+			{
+				if (Full())
+				{
+					if (!Overwrite) return NULL;
+					Pop();
+				}
+
+				T *res = new (At(head)) T(SForward<Args>(args)...);
+				++head;
+
+				return res;
+			}
+
+			// Same as Push ( SList compatible ).
+			T *Add(const T& data) { return Emplace(data); }
+			T *Add(T&& data) { return Emplace(SMove(data)); }
+
+			// Pointer to the oldest element or NULL if empty.
+			T *Peek() { return Empty() ? NULL : At(tail); }
+
+			// Discards the oldest element.
+			// Returns false if empty.
+			bool Pop()
+			{
+				if (Empty()) return false;
+
+				At(tail)->~T();
+				++tail;
+
+				return true;
+			}
+
+			// Moves the oldest element into `data' removing it from the ring.
+			// Returns false if empty.
+			bool Pop(T& data)
+			{
+				if (Empty()) return false;
+
+				data = SMove(*At(tail));
+				return Pop();
+			}
+
+			// Clear the ring calling the destructor of contained templated
+			// data objects.
+			void Clear()
+			{
+				while (Pop());
+			}
+
+			// Remove the element by idx ( 0 is the oldest ) shifting
+			// following ones.
+			// It does nothing if invalid index out of bounds.
+			void Remove(uint16_t idx)
+			{
+				uint16_t size = Size();
+				if (idx >= size) return; // arg exception
+
+				for (uint16_t i = idx + 1; i < size; ++i)
+					*At(tail + i - 1) = SMove(*At(tail + i));
+
+				--head;
+				At(head)->~T();
+			}
+
+			// Retrieve a reference of the template object at the given `idx'
+			// ( 0 is the oldest ).
+			// Pre: `idx' < Size().
+			T& Get(uint16_t idx) { return *At(tail + idx); }
+			const T& Get(uint16_t idx) const { return *At(tail + idx); }
+		};
+
+	}
+
+}
+
+#endif
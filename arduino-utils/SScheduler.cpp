@@ -0,0 +1,20 @@
+#include "DebugMacros.h"
+#include "DPrint.h"
+
+#include "SScheduler.h"
+
+namespace SearchAThing
+{
+
+	namespace Arduino
+	{
+
+		void PrintTaskStats(int8_t id, const STaskStats& stats)
+		{
+			DLogln(F("task "), id, F(" runs="), stats.runs, F(" total="), stats.totalTime,
+				F(" max="), stats.maxTime, F(" overruns="), stats.overruns);
+		}
+
+	}
+
+}
@@ -0,0 +1,280 @@
+#ifndef _SEARCHATHING_ARDUINO_UTILS_SSCHEDULER_H
+#define _SEARCHATHING_ARDUINO_UTILS_SSCHEDULER_H
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include "DebugMacros.h"
+
+// SleepFor() result when there are no tasks scheduled.
+#define SSCHEDULER_IDLE ((unsigned long)-1)
+
+namespace SearchAThing
+{
+
+	namespace Arduino
+	{
+
+		// Task callback receiving the context given at schedule time.
+		typedef void (*STaskFn)(void *ctx);
+
+		// Clock function ( eg. millis, micros ).
+		typedef unsigned long (*SClockFn)();
+
+		// Per task statistics ( times in clock units ).
+		struct STaskStats
+		{
+			// number of runs
+			uint32_t runs;
+
+			// sum of run times
+			unsigned long totalTime;
+
+			// longest run time
+			unsigned long maxTime;
+
+			// periodic runs started a whole period or more late ( missed
+			// periods are skipped, not recovered )
+			uint16_t overruns;
+		};
+
+		// Cooperative scheduler of up to `N' periodic or one-shot tasks to be
+		// driven by calling Run() from loop().
+		// Deadlines are compared through signed difference thus they keep
+		// working across clock rollover ( millis() wraps every ~49 days )
+		// provided no task is delayed more than half the clock range.
+		// Pending tasks are kept in a min-heap by deadline so the next due
+		// one is known in O(1) and schedule/cancel cost O(log N).
+		template<uint8_t N>
+		class SScheduler
+		{
+			// task ids are int8_t ( -1 for errors )
+			static_assert(N > 0 && N <= 127, "SScheduler size must be 1..127");
+
+			static const uint8_t NONE = 0xff;
+
+			struct Task
+			{
+				STaskFn fn;
+				void *ctx;
+				unsigned long due;
+
+				// 0 for one-shot tasks
+				unsigned long period;
+
+				// index in the heap or NONE if not pending
+				uint8_t heapPos;
+
+				bool used;
+
+				STaskStats stats;
+			};
+
+			Task tasks[N];
+
+			// task indexes min-ordered by due time
+			uint8_t heap[N];
+			uint8_t heapSize = 0;
+
+			// task being executed by Run() ( its slot isn't reused until
+			// it returns )
+			uint8_t running = NONE;
+
+			SClockFn clock;
+
+			// True if task `a' is due before task `b'.
+			bool Before(uint8_t a, uint8_t b) const
+			{
+				return (long)(tasks[a].due - tasks[b].due) < 0;
+			}
+
+			void HeapSet(uint8_t pos, uint8_t idx)
+			{
+				heap[pos] = idx;
+				tasks[idx].heapPos = pos;
+			}
+
+			void SiftUp(uint8_t pos)
+			{
+				uint8_t idx = heap[pos];
+				while (pos > 0)
+				{
+					uint8_t parent = (pos - 1) / 2;
+					if (!Before(idx, heap[parent])) break;
+					HeapSet(pos, heap[parent]);
+					pos = parent;
+				}
+				HeapSet(pos, idx);
+			}
+
+			void SiftDown(uint8_t pos)
+			{
+				uint8_t idx = heap[pos];
+				while (true)
+				{
+					uint8_t child = 2 * pos + 1;
+					if (child >= heapSize) break;
+					if (child + 1 < heapSize && Before(heap[child + 1], heap[child])) ++child;
+					if (!Before(heap[child], idx)) break;
+					HeapSet(pos, heap[child]);
+					pos = child;
+				}
+				HeapSet(pos, idx);
+			}
+
+			void HeapRemove(uint8_t idx)
+			{
+				uint8_t pos = tasks[idx].heapPos;
+				tasks[idx].heapPos = NONE;
+				if (--heapSize == pos) return;
+
+				HeapSet(pos, heap[heapSize]);
+				if (pos > 0 && Before(heap[pos], heap[(pos - 1) / 2]))
+					SiftUp(pos);
+				else
+					SiftDown(pos);
+			}
+
+			int8_t Schedule(unsigned long delay, unsigned long period, STaskFn fn, void *ctx)
+			{
+				for (uint8_t i = 0; i < N; ++i)
+				{
+					if (tasks[i].used || i == running) continue;
+
+					Task& t = tasks[i];
+					t.fn = fn;
+					t.ctx = ctx;
+					t.due = clock() + delay;
+					t.period = period;
+					t.used = true;
+					t.stats = STaskStats();
+
+					HeapSet(heapSize, i);
+					SiftUp(heapSize++);
+
+					return i;
+				}
+
+				DLOG_IF(DLOG_ERROR, DLOG_CH_SCHED) DLogln(F("scheduler full"));
+				return -1;
+			}
+
+		public:
+			// Builds a scheduler using the given `clock' ( all times given
+			// to and returned by the scheduler are in `clock' units ).
+			SScheduler(SClockFn _clock = millis) : clock(_clock)
+			{
+				for (uint8_t i = 0; i < N; ++i)
+				{
+					tasks[i].used = false;
+					tasks[i].heapPos = NONE;
+				}
+			}
+
+			// Schedules `fn(ctx)' to run every `period' ( > 0 ) starting
+			// after `delay'. Returns task id or -1 if the table is full.
+			int8_t Every(unsigned long period, STaskFn fn, void *ctx = NULL, unsigned long delay = 0)
+			{
+				return Schedule(delay, period, fn, ctx);
+			}
+
+			// Schedules `fn(ctx)' to run once after `delay'.
+			// Returns task id or -1 if the table is full.
+			int8_t After(unsigned long delay, STaskFn fn, void *ctx = NULL)
+			{
+				return Schedule(delay, 0, fn, ctx);
+			}
+
+			// Cancels the given task ( can be called from a task too ).
+			void Cancel(int8_t id)
+			{
+				if (id < 0 || id >= N || !tasks[id].used) return;
+
+				if (tasks[id].heapPos != NONE) HeapRemove(id);
+				tasks[id].used = false;
+			}
+
+			// True if the given task is scheduled.
+			bool Active(int8_t id) const
+			{
+				return id >= 0 && id < N && tasks[id].used;
+			}
+
+			// Statistics of the given task ( kept after a one-shot task
+			// completes until its slot is reused ) ; all zero for an id out
+			// of range ( eg. -1 from a full table ).
+			const STaskStats& Stats(int8_t id) const
+			{
+				static const STaskStats none = STaskStats();
+
+				if (id < 0 || id >= N) return none;
+				return tasks[id].stats;
+			}
+
+			// Number of scheduled tasks.
+			uint8_t Size() const { return heapSize; }
+
+			// Time until the next task is due ( 0 if already due ) or
+			// SSCHEDULER_IDLE if there are no tasks.
+			unsigned long SleepFor() const
+			{
+				if (heapSize == 0) return SSCHEDULER_IDLE;
+
+				long d = (long)(tasks[heap[0]].due - clock());
+				return d > 0 ? d : 0;
+			}
+
+			// Runs tasks due by now, each at most once, and returns
+			// SleepFor().
+			unsigned long Run()
+			{
+				unsigned long now = clock();
+
+				for (uint8_t n = 0; n < N && heapSize > 0; ++n)
+				{
+					uint8_t idx = heap[0];
+					Task& t = tasks[idx];
+					if ((long)(now - t.due) < 0) break;
+
+					if (t.period == 0)
+						HeapRemove(idx);
+					else
+					{
+						if (now - t.due >= t.period)
+						{
+							++t.stats.overruns;
+							t.due = now + t.period;
+						}
+						else
+							t.due += t.period;
+						SiftDown(0);
+					}
+
+					running = idx;
+					unsigned long start = clock();
+					t.fn(t.ctx);
+					unsigned long dt = clock() - start;
+					running = NONE;
+
+					++t.stats.runs;
+					t.stats.totalTime += dt;
+					if (dt > t.stats.maxTime) t.stats.maxTime = dt;
+
+					if (t.period == 0) t.used = false;
+				}
+
+				return SleepFor();
+			}
+		};
+
+		// Prints given task statistics prefixed by task `id'.
+		void PrintTaskStats(int8_t id, const STaskStats& stats);
+
+	}
+
+}
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef _SEARCHATHING_ARDUINO_UTILS_SVECTOR_H
+#define _SEARCHATHING_ARDUINO_UTILS_SVECTOR_H
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include "DebugMacros.h"
+#include "Move.h"
+
+#include <new.h> // placement new
+
+namespace SearchAThing
+{
+
+	namespace Arduino
+	{
+
+		// Templated fixed capacity vector.
+		// Store up to `N' templated elements `T' contiguously inside the
+		// object itself ( no heap allocation ) with O(1) indexed access.
+		// Exposes the same Size/Get/Remove/Clear surface of SList.
+		template<class T, uint16_t N>
+		class SVector
+		{
+			uint16_t size = 0;
+			alignas(T) byte storage[N * sizeof(T)];
+
+			T *Data() { return (T *)storage; }
+			const T *Data() const { return (const T *)storage; }
+
+		public:
+			// Default constructor.
+			SVector()
+			{
+			}
+
+			// Copy constructor.
+			SVector(const SVector& other)
+			{
+				*this = other;
+			}
+
+			// Move constructor. Moves elements of the given `other' vector
+			// leaving it empty.
+			SVector(SVector&& other)
+			{
+				*this = SMove(other);
+			}
+
+			// Assign operator. Creates a copy of the given `other' vector.
+			SVector& operator = (const SVector& other)
+			{
+				if (this == &other) return *this;
+
+				Clear();
+				for (uint16_t i = 0; i < other.size; ++i) Add(other.Get(i));
+
+				return *this;
+			}
+
+			// Move assign operator. Moves elements of the given `other'
+			// vector leaving it empty.
+			SVector& operator = (SVector&& other)
+			{
+				if (this == &other) return *this;
+
+				Clear();
+				for (uint16_t i = 0; i < other.size; ++i) Add(SMove(other.Get(i)));
+				other.Clear();
+
+				return *this;
+			}
+
+			// Destructor. Calls destructor of stored templated objects.
+			~SVector()
+			{
+				Clear();
+			}
+
+			// Current vector size.
+			uint16_t Size() const { return size; }
+
+			// Max number of elements.
+			uint16_t Capacity() const { return N; }
+
+			// True if no more elements can be added.
+			bool Full() const { return size == N; }
+
+			// Adds a copy of given templated object `data' to the vector.
+			// Returns pointer to the stored object or NULL if full.
+			T *Add(const T& data)
+			{
+				return Emplace(data);
+			}
+
+			// Moves given templated object `data' into the vector.
+			// Returns pointer to the stored object or NULL if full.
+			T *Add(T&& data)
+			{
+				return Emplace(SMove(data));
+			}
+
+			// Adds to the vector a templated object constructed in place with
+			// given arguments.
+			// Returns pointer to the stored object or NULL if full.
+			template<class... Args>
+			T *Emplace(Args&&... args)
+			{
+				if (size == N) return NULL;
+
+				T *res = new (Data() + size) T(SForward<Args>(args)...);
+				++size;
+
+				return res;
+			}
+
+			// Clear the vector calling the destructor of contained templated
+			// data objects.
+			void Clear()
+			{
+				while (size > 0) Data()[--size].~T();
+			}
+
+			// Remove the element by idx ( 0 is the first ) shifting down
+			// following ones.
+			// It does nothing if invalid index out of bounds.
+			void Remove(uint16_t idx)
+			{
+				if (idx >= size) return; // arg exception
+
+				T *data = Data();
+				for (uint16_t i = idx + 1; i < size; ++i) data[i - 1] = SMove(data[i]);
+
+				data[--size].~T();
+			}
+
+			// Retrieve a reference of the template object at the given `idx'.
+			// Pre: `idx' < Size().
+			T& Get(uint16_t idx) { return Data()[idx]; }
+			const T& Get(uint16_t idx) const { return Data()[idx]; }
+
+			T& operator [] (uint16_t idx) { return Data()[idx]; }
+			const T& operator [] (uint16_t idx) const { return Data()[idx]; }
+
+			// Iterator to the first element.
+			T *begin() { return Data(); }
+			const T *begin() const { return Data(); }
+
+			// Iterator past the last element.
+			T *end() { return Data() + size; }
+			const T *end() const { return Data() + size; }
+		};
+
+	}
+
+}
+
+#endif
@@ -16,6 +16,7 @@ extern char *__brkval;
 extern struct __freelist *__flp;
 extern size_t __malloc_margin;
 extern char *__malloc_heap_start;
+extern char *__malloc_heap_end;
 extern char __heap_start;
 
 extern char *__data_start;
@@ -25,15 +26,17 @@ extern char *__bss_end;
 //---------------------------------------------------------------------------
 
 #include <limits.h> // ULONG_MAX
+#include <math.h> // isnan, isinf, signbit
 //#include <MemoryFree\MemoryFree.h> // freeMemory()
 
 #include "Util.h"
 #include "SList.h"
+#include "DCbor.h"
 
 int freeMemory()
 {	
 	int v;
-	return (int)&v - (__brkval == 0 ? (int)&__heap_start : (int)__brkval);
+	return (int)(size_t)&v - (__brkval == 0 ? (int)(size_t)&__heap_start : (int)(size_t)__brkval);
 }
 
 namespace SearchAThing
@@ -49,61 +52,88 @@ namespace SearchAThing
 
 		int FreeMemoryMaxBlock(int upper)
 		{
-			int size = upper;
+			// largest chunk in the free list
+			size_t maxBlock = 0;
+			for (struct __freelist *fp = __flp; fp != NULL; fp = fp->nx)
+			{
+				if (fp->sz > maxBlock) maxBlock = fp->sz;
+			}
+
+			// room between heap top and the malloc limit ( same computation
+			// of avr-libc malloc when the free list can't satisfy a request )
+			char *brk = __brkval != 0 ? __brkval : __malloc_heap_start;
+			char *limit = __malloc_heap_end != 0 ?
+				__malloc_heap_end : (char *)(SP - __malloc_margin);
+
+			size_t avail = 0;
+			if (limit > brk + sizeof(size_t))
+				avail = limit - brk - sizeof(size_t);
+
+			DLOG_IF(DLOG_TRACE, DLOG_CH_MEM)
+			{
+				DLogln(F("free list max="), maxBlock, F(" heap top avail="), avail);
+			}
+
+			if (avail > maxBlock) maxBlock = avail;
+			if (maxBlock > (size_t)upper) maxBlock = upper;
+
+			return maxBlock;
+		}
+
+#ifdef FREE_MEMORY_MAX_BISECT
+		int FreeMemoryMaxBlockBisect(int upper)
+		{
+			// largest size known to succeed and smallest known to fail
 			int lower = 0;
+			int fail = upper + 1;
 
-#if defined DEBUG && defined DEBUG_FREE_MEMORY_MAX
-			DPrintln();
-#endif
+			DLOG_IF(DLOG_TRACE, DLOG_CH_MEM) { DPrintln(); }
 
-			while ((upper - lower) > 1)
+			while ((fail - lower) > 1)
 			{
-#if defined DEBUG && defined DEBUG_FREE_MEMORY_MAX
-				DPrint("try="); DPrint(size);
-#endif
+				int size = lower + (fail - lower) / 2;
+
+				DLOG_IF(DLOG_TRACE, DLOG_CH_MEM)
+				{
+					DPrintF(F("try=")); DPrintInt16(size);
+				}
 
 				void *buf = malloc(size);
 
 				if (buf == NULL)
 				{
-#if defined DEBUG && defined DEBUG_FREE_MEMORY_MAX
-					DPrint(" fail\t");
-#endif
-					// exclude size as upper limit decreasing by 1
-					upper = size - 1;
+					DLOG_IF(DLOG_TRACE, DLOG_CH_MEM) { DPrintF(F(" fail\t")); }
+
+					fail = size;
 				}
 				else // successful on size
 				{
-#if defined DEBUG && defined DEBUG_FREE_MEMORY_MAX
-					DPrint(" ok\t");
-#endif
+					DLOG_IF(DLOG_TRACE, DLOG_CH_MEM) { DPrintF(F(" ok\t")); }
 
 					free(buf);
-					// sets new lower limit
 					lower = size;
 				}
 
-				// checks between half of upper-lower bounds
-				size = lower + (upper - lower) / 2;
-
-#if defined DEBUG && defined DEBUG_FREE_MEMORY_MAX
-				DPrint("upper="); DPrint(upper); DPrint(" size="); DPrint(size); DPrint(" lower="); DPrint(lower);
-				DPrint(" diff="); DPrintln(upper - lower);
-#endif				
+				DLOG_IF(DLOG_TRACE, DLOG_CH_MEM)
+				{
+					DPrintF(F("fail=")); DPrintInt16(fail);
+					DPrintF(F(" lower=")); DPrintInt16ln(lower);
+				}
 			}
 
-			return size + 4 * sizeof(int) + sizeof(void *);
+			return lower;
 		}
+#endif
 
 		void PrintFreeMemory()
 		{
-			DPrintF(F("free blk=")); DPrintInt16(FreeMemoryMaxBlock());
-			DPrintF(F(" frg=")); DPrintInt16ln(FreeMemorySum());
+			DLogln(F("free blk="), FreeMemoryMaxBlock(), F(" frg="), FreeMemorySum());
 		}
 
 		// http://www.nongnu.org/avr-libc/user-manual/malloc.html
 		void PrintRAMLayout()
 		{
+#ifdef DPRINT_SERIAL
 			byte stack = 0;
 
 			void *myCurStack = &stack;
@@ -128,7 +158,7 @@ namespace SearchAThing
 
 			DNewline();
 			DPrintF(F("SP\t\t\t")); DPrintHexln(SP, true);
-			DPrintF(F("myCurStack\t\t")); DPrintHexln((uint16_t)&myCurStack, true);
+			DPrintF(F("myCurStack\t\t")); DPrintHexln((uint16_t)(size_t)&myCurStack, true);
 			DPrintF(F("RAMEND\t\t\t")); DPrintHexln((uint16_t)RAMEND, true);
 
 			// Free List
@@ -149,15 +179,48 @@ namespace SearchAThing
 
 				fp = fp->nx;
 			}
+#endif
+		}
 
+		void PrintRAMLayoutCbor()
+		{
+#ifdef DPRINT_SERIAL
+			byte stack = 0;
+
+			// keys documented in Util.h
+			DCborMap(14);
+			DCborKeyUInt(0, __malloc_margin);
+			DCborKeyUInt(1, (uint16_t)(size_t)&__data_start);
+			DCborKeyUInt(2, (uint16_t)(size_t)&__data_end);
+			DCborKeyUInt(3, (uint16_t)(size_t)&__bss_start);
+			DCborKeyUInt(4, (uint16_t)(size_t)&__bss_end);
+			DCborKeyUInt(5, (uint16_t)(size_t)__malloc_heap_start);
+			DCborKeyUInt(6, (uint16_t)(size_t)&__heap_start);
+			DCborKeyUInt(7, (uint16_t)(size_t)__brkval);
+			DCborKeyUInt(8, (uint16_t)(SP - __malloc_margin));
+			DCborKeyUInt(9, SP);
+			DCborKeyUInt(10, (uint16_t)(size_t)&stack);
+			DCborKeyUInt(11, (uint16_t)RAMEND);
+			DCborKeyUInt(12, (uint16_t)(size_t)__flp);
+
+			DCborUInt(13);
+			DCborArrayBegin();
+			for (struct __freelist *fp = __flp; fp != NULL; fp = fp->nx)
+			{
+				DCborArray(3);
+				DCborUInt((uint16_t)(size_t)fp);
+				DCborUInt(fp->sz);
+				DCborUInt((uint16_t)(size_t)fp->nx);
+			}
+			DCborBreak();
+#endif
 		}
 
 		unsigned long TimeDiff(unsigned long start, unsigned long now)
 		{
-			if (start <= now)
-				return now - start;
-			else
-				return (ULONG_MAX - start) + now + 1;
+			// unsigned subtraction wraps modulo 2^32 thus it holds across
+			// millis() rollover too
+			return now - start;
 		}
 
 		void BufWrite16(byte *buf, uint16_t v)
@@ -190,34 +253,193 @@ namespace SearchAThing
 				buf[3];
 		}
 
+		static const uint32_t _pow10[] PROGMEM =
+		{
+			1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL,
+			10000000UL, 100000000UL, 1000000000UL
+		};
+
+		static const uint16_t _pow10_16[] PROGMEM =
+		{
+			1U, 10U, 100U, 1000U, 10000U
+		};
+
+		char *UInt16ToDec(char *buf, uint16_t v, uint8_t digits)
+		{
+			bool started = false;
+
+			for (int8_t i = 4; i >= 0; --i)
+			{
+				uint16_t d = pgm_read_word(&_pow10_16[i]);
+				char c = '0';
+				while (v >= d)
+				{
+					v -= d;
+					++c;
+				}
+
+				if (started || c != '0' || i < digits)
+				{
+					*buf++ = c;
+					started = true;
+				}
+			}
+
+			return buf;
+		}
+
+		char *UInt32ToDec(char *buf, uint32_t v, uint8_t digits)
+		{
+			bool started = false;
+
+			for (int8_t i = 9; i >= 4; --i)
+			{
+				uint32_t d = pgm_read_dword(&_pow10[i]);
+				char c = '0';
+				while (v >= d)
+				{
+					v -= d;
+					++c;
+				}
+
+				if (started || c != '0' || i < digits)
+				{
+					*buf++ = c;
+					started = true;
+				}
+			}
+
+			// remainder is below 10000: completes with 16bit ops
+			return UInt16ToDec(buf, (uint16_t)v, started ? 4 : digits);
+		}
+
+		char *Int16ToDec(char *buf, int16_t v)
+		{
+			uint16_t x = v;
+			if (v < 0)
+			{
+				*buf++ = '-';
+				x = -x;
+			}
+			return UInt16ToDec(buf, x);
+		}
+
+		char *Int32ToDec(char *buf, int32_t v)
+		{
+			uint32_t x = v;
+			if (v < 0)
+			{
+				*buf++ = '-';
+				x = -x;
+			}
+			return UInt32ToDec(buf, x);
+		}
+
+		static const char _hexDigits[] PROGMEM = "0123456789abcdef";
+
+		char *ByteToHex(char *buf, byte b)
+		{
+			buf[0] = pgm_read_byte(&_hexDigits[b >> 4]);
+			buf[1] = pgm_read_byte(&_hexDigits[b & 0x0f]);
+			return buf + 2;
+		}
+
 		void FloatToString(char *buf, float f, int prec)
 		{
-			auto x = (int32_t)f;
+			char *p = buf;
 
-			ltoa(x, buf, DEC);
-			
-			if (prec > 0)
+			if (isnan(f))
 			{
-				char *p = buf + strlen(buf);
-				*p = '.';
-				++p;
+				strcpy(p, "nan");
+				return;
+			}
 
-				if (x < 0) { x *= -1L; f *= -1.0; }
+			if (signbit(f))
+			{
+				*p++ = '-';
+				f = -f;
+			}
+
+			if (isinf(f))
+			{
+				strcpy(p, "inf");
+				return;
+			}
 
-				auto frac = f - (float)x;
-				
-				while (prec)
+			if (prec < 0) prec = 0;
+			else if (prec > 7) prec = 7;
+
+			// values that doesn't fit 32bit are normalized to exponent form
+			uint8_t exp = 0;
+			if (f >= 4294967296.0f)
+			{
+				while (f >= 10.0f)
 				{
-					frac *= 10.0;
-					auto y = (uint32_t)frac;
-					*p = (byte)'0' + (byte)y;
-					++p;
+					f /= 10.0f;
+					++exp;
+				}
+			}
 
-					frac -= y;
-					--prec;
+			// split f = m * 2^-sh into exact integer part and remainder
+			// then scale the remainder in fixed point rounding half up
+			// in integer arithmetic ( r < 2^24 and scale < 2^24 so the
+			// product always fits 48 bits )
+			uint32_t bits;
+			memcpy(&bits, &f, sizeof(bits));
+			int16_t e = (bits >> 23) & 0xff;
+			uint32_t m = bits & 0x7fffffUL;
+			if (e == 0) e = 1; // subnormal
+			else m |= 0x800000UL;
+			int16_t sh = 150 - e;
+
+			uint32_t scale = pgm_read_dword(&_pow10[prec]);
+			uint32_t x = 0;
+			uint32_t frac = 0;
+			if (sh <= 0)
+				x = m << -sh; // f < 2^32 here
+			else if (sh <= 48)
+			{
+				uint32_t r = m;
+				if (sh < 24)
+				{
+					x = m >> sh;
+					r = m & ((1UL << sh) - 1);
 				}
-				*p = 0;
+				uint64_t q = (uint64_t)r * scale;
+				frac = (uint32_t)(q >> sh);
+				if ((q >> (sh - 1)) & 1) ++frac;
 			}
+			// else f < 2^-25 rounds to zero at any prec
+
+			if (frac >= scale)
+			{
+				frac -= scale;
+				++x;
+
+				// mantissa rounded up to 10 ( eg. 9.9999e+10 -> 1.00e+11 )
+				if (exp > 0 && x == 10)
+				{
+					x = 1;
+					++exp;
+				}
+			}
+
+			p = UInt32ToDec(p, x, 1);
+
+			if (prec > 0)
+			{
+				*p++ = '.';
+				p = UInt32ToDec(p, frac, prec);
+			}
+
+			if (exp > 0)
+			{
+				*p++ = 'e';
+				*p++ = '+';
+				p = UInt32ToDec(p, exp, 2);
+			}
+
+			*p = 0;
 		}
 	}
 
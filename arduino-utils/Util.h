@@ -20,11 +20,21 @@ namespace SearchAThing
 		// Returns available fragmented free memory available.
 		int FreeMemorySum();
 
-		// Returns max contiguous block of ram free by testing through a
-		// bisection algorithm that starts from the `upperLimit' given
-		// checking using the `malloc' exitcode.
+		// Returns the largest size a malloc would succeed with ( limited to
+		// the `upperLimit' given ) computed in one pass as the largest
+		// between free list chunks and the room left from heap top to the
+		// malloc limit ( SP - __malloc_margin or __malloc_heap_end ) less
+		// the chunk size header.
+		// It doesn't allocate memory.
 		int FreeMemoryMaxBlock(int upperLimit = BOARD_MAX_MEMORY);
 
+#ifdef FREE_MEMORY_MAX_BISECT
+		// Returns the largest size a malloc succeeds with ( up to the
+		// `upperLimit' given ) found by bisection over malloc / free calls.
+		// Available to cross-check FreeMemoryMaxBlock results.
+		int FreeMemoryMaxBlockBisect(int upperLimit = BOARD_MAX_MEMORY);
+#endif
+
 		// Prints total fragmented memory available and the max contiguos
 		// block of free ram allocatable.
 		void PrintFreeMemory();
@@ -32,9 +42,21 @@ namespace SearchAThing
 		// Prints the ram layout (data,bss,heap,stack).
 		void PrintRAMLayout();
 
+		// Writes the ram layout as a CBOR map ( see DCbor.h ) with
+		// integer keys for the PrintRAMLayout values:
+		//
+		//   0 __malloc_margin       7 __brkval
+		//   1 __data_start          8 SP - __malloc_margin
+		//   2 __data_end            9 SP
+		//   3 __bss_start          10 current stack
+		//   4 __bss_end            11 RAMEND
+		//   5 __malloc_heap_start  12 __flp
+		//   6 __heap_start         13 free list: array of [ fp, sz, nx ]
+		void PrintRAMLayoutCbor();
+
 		// Compute time delta (ms) between given `now' and reference `start'.
 		// Pre: `start' must be a value of time taken from millis()
-		// effectively before the `now.
+		// effectively before the `now' ( less than ~49 days before ).
 		unsigned long TimeDiff(unsigned long start, unsigned long now);
 
 		// Write the given unsigned 16bit integer into the given bytes buffer
@@ -53,8 +75,39 @@ namespace SearchAThing
 		// 32bit integer (msb mode).
 		uint32_t BufReadUInt32_t(byte *buf);
 
-		// Converts the given float into a string.
-		void FloatToString(char *buf, float f, int prec);	
+		// Writes decimal digits of the given unsigned 16bit integer into
+		// `buf' ( at least `digits' digits zero padded, not null terminated ).
+		// Returns pointer past the last written char.
+		char *UInt16ToDec(char *buf, uint16_t v, uint8_t digits = 1);
+
+		// Writes decimal digits of the given unsigned 32bit integer into
+		// `buf' ( at least `digits' digits zero padded, not null terminated ).
+		// Returns pointer past the last written char.
+		char *UInt32ToDec(char *buf, uint32_t v, uint8_t digits = 1);
+
+		// Writes decimal digits of the given signed 16bit integer ( '-'
+		// prefixed if negative ) into `buf' ( up to 6 chars, not null
+		// terminated ). Returns pointer past the last written char.
+		char *Int16ToDec(char *buf, int16_t v);
+
+		// Writes decimal digits of the given signed 32bit integer ( '-'
+		// prefixed if negative ) into `buf' ( up to 11 chars, not null
+		// terminated ). Returns pointer past the last written char.
+		char *Int32ToDec(char *buf, int32_t v);
+
+		// Writes the two lowercase hexadecimal digits of the given byte
+		// into `buf' ( not null terminated ).
+		// Returns pointer past the last written char.
+		char *ByteToHex(char *buf, byte b);
+
+		// Converts the given float into a string with `prec' decimals
+		// ( clamped to 0..7 ) rounding half up. Digits are exact ( computed
+		// from the binary value in integer arithmetic ) for values printed
+		// without exponent. Prints "nan", "inf", "-inf"
+		// for non finite values and uses exponent form ( eg. "1.23e+12" )
+		// for values beyond 32bit integer range.
+		// Given `buf' must hold at least 20 chars.
+		void FloatToString(char *buf, float f, int prec);
 
 	}
 
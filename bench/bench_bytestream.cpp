@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include "ByteStream.h"
+#include "Util.h"
+
+using namespace SearchAThing::Arduino;
+
+// Serializes a record of four 32 bit and four 16 bit big endian fields
+// with ByteWriter / ByteReader and with the Util BufWrite / BufRead
+// helpers at hand computed offsets.
+
+#define RECORD_SIZE 24
+
+static void BM_ByteWriterRecord(benchmark::State& state)
+{
+    byte buf[RECORD_SIZE];
+    benchmark::DoNotOptimize(buf);
+    uint32_t v = 0x12345678;
+    for (auto _ : state)
+    {
+        ByteWriter w(buf, sizeof(buf));
+        for (int i = 0; i < 4; ++i) w.WriteU32BE(v + i);
+        for (int i = 0; i < 4; ++i) w.WriteU16BE((uint16_t)(v + i));
+        benchmark::DoNotOptimize(w.Ok());
+        benchmark::ClobberMemory();
+        ++v;
+    }
+}
+BENCHMARK(BM_ByteWriterRecord);
+
+static void BM_BufWriteRecord(benchmark::State& state)
+{
+    byte buf[RECORD_SIZE];
+    benchmark::DoNotOptimize(buf);
+    uint32_t v = 0x12345678;
+    for (auto _ : state)
+    {
+        for (int i = 0; i < 4; ++i) BufWrite32(buf + i * 4, v + i);
+        for (int i = 0; i < 4; ++i) BufWrite16(buf + 16 + i * 2, (uint16_t)(v + i));
+        benchmark::ClobberMemory();
+        ++v;
+    }
+}
+BENCHMARK(BM_BufWriteRecord);
+
+static void BM_ByteReaderRecord(benchmark::State& state)
+{
+    byte buf[RECORD_SIZE];
+    for (int i = 0; i < RECORD_SIZE; ++i) buf[i] = i * 7;
+    benchmark::DoNotOptimize(buf);
+    for (auto _ : state)
+    {
+        benchmark::ClobberMemory();
+        ByteReader r(buf, sizeof(buf));
+        uint32_t sum = 0;
+        for (int i = 0; i < 4; ++i) sum += r.ReadU32BE();
+        for (int i = 0; i < 4; ++i) sum += r.ReadU16BE();
+        benchmark::DoNotOptimize(sum);
+        benchmark::DoNotOptimize(r.Ok());
+    }
+}
+BENCHMARK(BM_ByteReaderRecord);
+
+static void BM_BufReadRecord(benchmark::State& state)
+{
+    byte buf[RECORD_SIZE];
+    for (int i = 0; i < RECORD_SIZE; ++i) buf[i] = i * 7;
+    benchmark::DoNotOptimize(buf);
+    for (auto _ : state)
+    {
+        benchmark::ClobberMemory();
+        uint32_t sum = 0;
+        for (int i = 0; i < 4; ++i) sum += BufReadUInt32_t(buf + i * 4);
+        for (int i = 0; i < 4; ++i) sum += BufReadUInt16_t(buf + 16 + i * 2);
+        benchmark::DoNotOptimize(sum);
+    }
+}
+BENCHMARK(BM_BufReadRecord);
+
+static void BM_Varint(benchmark::State& state)
+{
+    byte buf[5];
+    uint32_t v = 1;
+    for (auto _ : state)
+    {
+        ByteWriter w(buf, sizeof(buf));
+        w.WriteVarint(v);
+        ByteReader r(buf, w.Size());
+        benchmark::DoNotOptimize(r.ReadVarint());
+        v = v * 3 + 1;
+    }
+}
+BENCHMARK(BM_Varint);
@@ -0,0 +1,171 @@
+#include <benchmark/benchmark.h>
+
+#include <malloc.h>
+
+#include "SList.h"
+#include "SVector.h"
+#include "SRing.h"
+
+using namespace SearchAThing::Arduino;
+
+// SVector and SRing against SList holding uint16_t samples.
+// Each benchmark reports `bytes_per_elem': container footprint divided by
+// element count ( for SList nodes plus host malloc chunk overhead ; on
+// avr pointers are 2 bytes and malloc adds 2 bytes per block instead ).
+
+typedef uint16_t Sample;
+
+// n elements at capacity N ( SRing needs a power of two )
+#define CONTAINER_SIZES(B)                                   \
+    BENCHMARK_TEMPLATE(B, 10, 16);                           \
+    BENCHMARK_TEMPLATE(B, 100, 128);                         \
+    BENCHMARK_TEMPLATE(B, 1000, 1024)
+
+static double SListBytesPerElem(SList<Sample>& l)
+{
+    // malloc chunk: usable size plus the size header
+    void *p = malloc(sizeof(SListNode<Sample>));
+    size_t chunk = malloc_usable_size(p) + sizeof(size_t);
+    free(p);
+    return (double)(sizeof(l) + l.Size() * chunk) / l.Size();
+}
+
+//--
+
+template<uint16_t n, uint16_t N>
+static void BM_SListFill(benchmark::State& state)
+{
+    SList<Sample> l;
+    for (auto _ : state)
+    {
+        l.Clear();
+        for (uint16_t i = 0; i < n; ++i) l.Add(i);
+    }
+    state.counters["bytes_per_elem"] = SListBytesPerElem(l);
+    state.SetItemsProcessed(state.iterations() * n);
+}
+CONTAINER_SIZES(BM_SListFill);
+
+template<uint16_t n, uint16_t N>
+static void BM_SVectorFill(benchmark::State& state)
+{
+    SVector<Sample, N> v;
+    for (auto _ : state)
+    {
+        v.Clear();
+        for (uint16_t i = 0; i < n; ++i) v.Add(i);
+        benchmark::ClobberMemory();
+    }
+    state.counters["bytes_per_elem"] = (double)sizeof(v) / n;
+    state.SetItemsProcessed(state.iterations() * n);
+}
+CONTAINER_SIZES(BM_SVectorFill);
+
+template<uint16_t n, uint16_t N>
+static void BM_SRingFill(benchmark::State& state)
+{
+    SRing<Sample, N> r;
+    for (auto _ : state)
+    {
+        r.Clear();
+        for (uint16_t i = 0; i < n; ++i) r.Push(i);
+        benchmark::ClobberMemory();
+    }
+    state.counters["bytes_per_elem"] = (double)sizeof(r) / n;
+    state.SetItemsProcessed(state.iterations() * n);
+}
+CONTAINER_SIZES(BM_SRingFill);
+
+//--
+
+// sequential Get(i) over all elements
+
+template<class C>
+static void GetAll(benchmark::State& state, C& c, uint16_t n)
+{
+    for (auto _ : state)
+    {
+        uint32_t sum = 0;
+        for (uint16_t i = 0; i < c.Size(); ++i) sum += c.Get(i);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+template<uint16_t n, uint16_t N>
+static void BM_SListGet(benchmark::State& state)
+{
+    SList<Sample> l;
+    for (uint16_t i = 0; i < n; ++i) l.Add(i);
+    GetAll(state, l, n);
+}
+CONTAINER_SIZES(BM_SListGet);
+
+template<uint16_t n, uint16_t N>
+static void BM_SVectorGet(benchmark::State& state)
+{
+    SVector<Sample, N> v;
+    for (uint16_t i = 0; i < n; ++i) v.Add(i);
+    GetAll(state, v, n);
+}
+CONTAINER_SIZES(BM_SVectorGet);
+
+template<uint16_t n, uint16_t N>
+static void BM_SRingGet(benchmark::State& state)
+{
+    SRing<Sample, N> r;
+    for (uint16_t i = 0; i < n; ++i) r.Push(i);
+    GetAll(state, r, n);
+}
+CONTAINER_SIZES(BM_SRingGet);
+
+//--
+
+// fifo use: push one sample and drop the oldest
+
+template<uint16_t n, uint16_t N>
+static void BM_SListFifo(benchmark::State& state)
+{
+    SList<Sample> l;
+    for (uint16_t i = 0; i < n; ++i) l.Add(i);
+    Sample s = 0;
+    for (auto _ : state)
+    {
+        l.Add(++s);
+        l.Remove(0);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+CONTAINER_SIZES(BM_SListFifo);
+
+template<uint16_t n, uint16_t N>
+static void BM_SVectorFifo(benchmark::State& state)
+{
+    SVector<Sample, N + 1> v;
+    for (uint16_t i = 0; i < n; ++i) v.Add(i);
+    Sample s = 0;
+    for (auto _ : state)
+    {
+        v.Add(++s);
+        v.Remove(0);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+CONTAINER_SIZES(BM_SVectorFifo);
+
+template<uint16_t n, uint16_t N>
+static void BM_SRingFifo(benchmark::State& state)
+{
+    SRing<Sample, N> r;
+    for (uint16_t i = 0; i < n; ++i) r.Push(i);
+    Sample s = 0;
+    for (auto _ : state)
+    {
+        r.Pop();
+        r.Push(++s);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+CONTAINER_SIZES(BM_SRingFifo);
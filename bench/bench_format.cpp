@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+
+#include "DPrint.h"
+#include "Util.h"
+
+using namespace SearchAThing::Arduino;
+
+// DPrint benchmarks print into the host sink capture which is emptied
+// before it fills up ( a full capture would drop output ).
+static void ResetCapture()
+{
+    if (DPrintHostCaptureSize() > 2048) DPrintHostReset();
+}
+
+static void BM_DPrintUInt32(benchmark::State& state)
+{
+    uint32_t v = 1234567890;
+    for (auto _ : state)
+    {
+        DPrintUInt32(v, 12, '0');
+        v += 7919;
+        ResetCapture();
+    }
+    DPrintHostReset();
+}
+BENCHMARK(BM_DPrintUInt32);
+
+static void BM_DPrintInt16(benchmark::State& state)
+{
+    int16_t v = -12345;
+    for (auto _ : state)
+    {
+        DPrintInt16(v);
+        v += 7;
+        ResetCapture();
+    }
+    DPrintHostReset();
+}
+BENCHMARK(BM_DPrintInt16);
+
+static void BM_DPrintFloat(benchmark::State& state)
+{
+    float v = 3.14159f;
+    for (auto _ : state)
+    {
+        DPrintFloat(v, 3);
+        v += 0.37f;
+        ResetCapture();
+    }
+    DPrintHostReset();
+}
+BENCHMARK(BM_DPrintFloat);
+
+static void BM_DPrintHexDump(benchmark::State& state)
+{
+    byte buf[64];
+    for (int i = 0; i < 64; ++i) buf[i] = i;
+    for (auto _ : state)
+    {
+        DPrintHex(buf, sizeof(buf), true, true);
+        ResetCapture();
+    }
+    DPrintHostReset();
+}
+BENCHMARK(BM_DPrintHexDump);
+
+static void BM_FloatToString(benchmark::State& state)
+{
+    char buf[20];
+    float v = 1.0f;
+    for (auto _ : state)
+    {
+        FloatToString(buf, v, (int)state.range(0));
+        benchmark::DoNotOptimize(buf);
+        v *= 1.0001f;
+        if (v > 1e6f) v = 1.0f;
+    }
+}
+BENCHMARK(BM_FloatToString)->Arg(2)->Arg(7);
+
+// printf reference for FloatToString
+static void BM_SnprintfFloat(benchmark::State& state)
+{
+    char buf[20];
+    float v = 1.0f;
+    for (auto _ : state)
+    {
+        snprintf(buf, sizeof(buf), "%.*f", (int)state.range(0), (double)v);
+        benchmark::DoNotOptimize(buf);
+        v *= 1.0001f;
+        if (v > 1e6f) v = 1.0f;
+    }
+}
+BENCHMARK(BM_SnprintfFloat)->Arg(2)->Arg(7);
+
+static void BM_BufWriteRead32(benchmark::State& state)
+{
+    byte buf[4];
+    uint32_t v = 0x12345678;
+    for (auto _ : state)
+    {
+        BufWrite32(buf, v);
+        v = BufReadUInt32_t(buf) + 1;
+        benchmark::DoNotOptimize(v);
+    }
+}
+BENCHMARK(BM_BufWriteRead32);
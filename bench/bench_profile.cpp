@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+#include "DProfile.h"
+
+using namespace SearchAThing::Arduino;
+
+// Overhead of the DPROFILE_BEGIN / DPROFILE_END probes: the same small
+// work timed bare and wrapped by a probe pair ( on host the probe clock
+// is the shim micros() ).
+
+static uint32_t Work(uint32_t x)
+{
+    for (uint8_t i = 0; i < 8; ++i)
+    {
+        x = x * 1103515245u + 12345u;
+        benchmark::DoNotOptimize(x);
+    }
+    return x;
+}
+
+static void BM_ProfileBare(benchmark::State& state)
+{
+    uint32_t x = 1;
+    for (auto _ : state)
+        x = Work(x);
+    benchmark::DoNotOptimize(x);
+}
+BENCHMARK(BM_ProfileBare);
+
+static void BM_ProfileProbed(benchmark::State& state)
+{
+    uint32_t x = 1;
+    DProfileReset();
+    for (auto _ : state)
+    {
+        DPROFILE_BEGIN(0);
+        x = Work(x);
+        DPROFILE_END(0);
+    }
+    benchmark::DoNotOptimize(x);
+}
+BENCHMARK(BM_ProfileProbed);
+
+// empty probe pair ( what DProfileCalibrate measures )
+static void BM_ProfileEmptyPair(benchmark::State& state)
+{
+    DProfileReset();
+    for (auto _ : state)
+    {
+        DPROFILE_BEGIN(0);
+        DPROFILE_END(0);
+    }
+    benchmark::DoNotOptimize(_DProfileSlots[0].count);
+}
+BENCHMARK(BM_ProfileEmptyPair);
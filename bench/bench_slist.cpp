@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+
+#include "SList.h"
+
+using namespace SearchAThing::Arduino;
+
+// lists sizes compared by each benchmark
+#define SLIST_SIZES ->Arg(10)->Arg(100)->Arg(1000)
+
+static void Fill(SList<int>& l, int n)
+{
+    for (int i = 0; i < n; ++i) l.Add(i);
+}
+
+static void BM_SListAddClear(benchmark::State& state)
+{
+    int n = state.range(0);
+    SList<int> l;
+    for (auto _ : state)
+    {
+        Fill(l, n);
+        l.Clear();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_SListAddClear) SLIST_SIZES;
+
+// sequential Get(i) served by the cached cursor ( O(n) per loop )
+static void BM_SListGetSeq(benchmark::State& state)
+{
+    int n = state.range(0);
+    SList<int> l;
+    Fill(l, n);
+    for (auto _ : state)
+    {
+        int sum = 0;
+        for (int i = 0; i < l.Size(); ++i) sum += l.Get(i);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_SListGetSeq) SLIST_SIZES;
+
+// reference: each index walked from the first node as Get did before the
+// cursor ( O(n^2) per loop )
+static void BM_SListWalkFromFirst(benchmark::State& state)
+{
+    int n = state.range(0);
+    SList<int> l;
+    Fill(l, n);
+    for (auto _ : state)
+    {
+        int sum = 0;
+        for (int i = 0; i < l.Size(); ++i)
+        {
+            auto it = l.begin();
+            for (int j = 0; j < i; ++j) ++it;
+            sum += *it;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_SListWalkFromFirst) SLIST_SIZES;
+
+static void BM_SListIterate(benchmark::State& state)
+{
+    int n = state.range(0);
+    SList<int> l;
+    Fill(l, n);
+    for (auto _ : state)
+    {
+        int sum = 0;
+        for (auto& x : l) sum += x;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_SListIterate) SLIST_SIZES;
+
+// removes every other element scanning indexes forward
+static void BM_SListRemoveSeq(benchmark::State& state)
+{
+    int n = state.range(0);
+    SList<int> l;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        l.Clear();
+        Fill(l, n);
+        state.ResumeTiming();
+
+        for (int i = 0; i < l.Size(); ++i) l.Remove(i);
+    }
+    state.SetItemsProcessed(state.iterations() * n / 2);
+}
+BENCHMARK(BM_SListRemoveSeq) SLIST_SIZES;
@@ -0,0 +1,166 @@
+#ifndef _SEARCHATHING_ARDUINO_UTILS_HOST_ARDUINO_H
+#define _SEARCHATHING_ARDUINO_UTILS_HOST_ARDUINO_H
+
+//===========================================================================
+// HOST SHIM
+//---------------------------------------------------------------------------
+// Minimal stand-in of the Arduino core used to compile the library with
+// the host compiler ( see README host build ).
+// Flash strings are plain ram strings, registers are ordinary variables,
+// sleep returns at once ( see avr/sleep.h ) and memory symbols ( __brkval, __flp, ... ) are defined by
+// ArduinoShim.cpp thus ram telemetry values are meaningless on host unless
+// a test points the malloc heap to a buffer ( see _ShimMalloc ).
+//===========================================================================
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+//---------------------------------------------------------------------------
+// flash
+//---------------------------------------------------------------------------
+
+class __FlashStringHelper;
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(PSTR(s)))
+
+inline uint8_t pgm_read_byte(const void *p) { return *(const uint8_t *)p; }
+inline uint16_t pgm_read_word(const void *p) { uint16_t v; memcpy(&v, p, 2); return v; }
+inline uint32_t pgm_read_dword(const void *p) { uint32_t v; memcpy(&v, p, 4); return v; }
+
+//---------------------------------------------------------------------------
+// bits
+//---------------------------------------------------------------------------
+
+#define HEX 16
+#define DEC 10
+
+#define _BV(b) (1 << (b))
+#define bit_is_set(r, b) ((r) & _BV(b))
+#define bit_is_clear(r, b) (!((r) & _BV(b)))
+#define loop_until_bit_is_set(r, b) do { } while (bit_is_clear(r, b))
+#define highByte(w) ((uint8_t)((w) >> 8))
+#define lowByte(w) ((uint8_t)((w) & 0xff))
+
+//---------------------------------------------------------------------------
+// cpu ( atmega328 ram layout )
+//---------------------------------------------------------------------------
+
+#define RAMSTART 0x100
+#define RAMEND 0x8ff
+
+// stack pointer ( fixed near RAMEND )
+extern uint16_t SP;
+
+// status register ( interrupts enabled bit is SREG_I )
+extern volatile uint8_t SREG;
+#define SREG_I 7
+
+// watchdog ( atmega328 bits ; WDTCSR is a macro too because code checks
+// its availability with defined(WDTCSR) )
+extern volatile uint8_t MCUSR;
+extern volatile uint8_t WDTCSR;
+#define WDTCSR WDTCSR
+#define WDRF 3
+#define WDP0 0
+#define WDP1 1
+#define WDP2 2
+#define WDE 3
+#define WDCE 4
+#define WDP3 5
+#define WDIE 6
+#define WDIF 7
+
+// peripherals stopped by power-down ( atmega328 bits ; macros too for
+// the same reason as WDTCSR ) : uart receiver, timer pwm outputs and
+// timer1 / timer2 interrupts
+extern volatile uint8_t UCSR0B;
+extern volatile uint8_t TCCR0A;
+extern volatile uint8_t TCCR1A;
+extern volatile uint8_t TCCR2A;
+extern volatile uint8_t TIMSK1;
+extern volatile uint8_t TIMSK2;
+#define UCSR0B UCSR0B
+#define TCCR0A TCCR0A
+#define TCCR1A TCCR1A
+#define TCCR2A TCCR2A
+#define TIMSK1 TIMSK1
+#define TIMSK2 TIMSK2
+#define RXEN0 4
+#define COM0A1 7
+#define COM0B1 5
+#define COM1A1 7
+#define COM1B1 5
+#define COM2A1 7
+#define COM2B1 5
+
+//---------------------------------------------------------------------------
+// memory
+//---------------------------------------------------------------------------
+
+// avr-libc malloc / free algorithm ( free list __flp, heap top __brkval,
+// chunks with a size_t header ) over the __malloc_heap_start ..
+// __malloc_heap_end range when a test sets both, host malloc / free
+// otherwise. Library sources are built with SHIM_AVR_MALLOC thus their
+// allocations go through them.
+void *_ShimMalloc(size_t len);
+void _ShimFree(void *p);
+
+#ifdef SHIM_AVR_MALLOC
+#define malloc(len) _ShimMalloc(len)
+#define free(p) _ShimFree(p)
+#endif
+
+#define ISR(vector) extern "C" void vector(void)
+#define cli()
+#define sei()
+#define noInterrupts()
+#define interrupts()
+
+//---------------------------------------------------------------------------
+// time
+//---------------------------------------------------------------------------
+
+// Milliseconds / microseconds since program start ( host monotonic clock ).
+unsigned long millis();
+unsigned long micros();
+
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+//---------------------------------------------------------------------------
+// print
+//---------------------------------------------------------------------------
+
+// Base of output streams ( DPRINT_SINK_STREAM ).
+class Print
+{
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+
+    virtual size_t write(const uint8_t *buf, size_t size)
+    {
+        size_t n = 0;
+        while (size--) n += write(*buf++);
+        return n;
+    }
+
+    size_t write(const char *str) { return write((const uint8_t *)str, strlen(str)); }
+
+    virtual void flush() {}
+};
+
+class Stream : public Print
+{
+};
+
+#endif
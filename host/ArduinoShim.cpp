@@ -0,0 +1,218 @@
+#include "Arduino.h"
+#include "avr/sleep.h"
+
+#include <time.h>
+
+//===========================================================================
+// registers
+//===========================================================================
+
+uint16_t SP = RAMEND - 0x100;
+volatile uint8_t SREG = _BV(SREG_I);
+volatile uint8_t MCUSR = 0;
+volatile uint8_t WDTCSR = 0;
+volatile uint8_t UCSR0B = 0;
+volatile uint8_t TCCR0A = 0;
+volatile uint8_t TCCR1A = 0;
+volatile uint8_t TCCR2A = 0;
+volatile uint8_t TIMSK1 = 0;
+volatile uint8_t TIMSK2 = 0;
+
+//===========================================================================
+// sleep ( see avr/sleep.h )
+//===========================================================================
+
+uint8_t _ShimSleepMode = 0;
+void (*_ShimSleepHook)(uint8_t mode) = NULL;
+
+//===========================================================================
+// avr-libc malloc and linker symbols used by ram telemetry
+//---------------------------------------------------------------------------
+// __data_start and __bss_start are already provided by the host crt and
+// linker thus they aren't defined here.
+//===========================================================================
+
+char *__brkval = NULL;
+struct __freelist *__flp = NULL;
+size_t __malloc_margin = 128;
+char *__malloc_heap_start = NULL;
+char *__malloc_heap_end = NULL;
+char __heap_start;
+char *__data_end = NULL;
+char *__bss_end = NULL;
+
+struct __freelist
+{
+    size_t sz;
+    struct __freelist *nx;
+};
+
+static bool _ShimAvrHeap(const void *p)
+{
+    return __malloc_heap_start != NULL && __malloc_heap_end != NULL &&
+        (p == NULL || ((const char *)p >= __malloc_heap_start && (const char *)p < __malloc_heap_end));
+}
+
+// avr-libc malloc.c
+void *_ShimMalloc(size_t len)
+{
+    if (!_ShimAvrHeap(NULL)) return malloc(len);
+
+    struct __freelist *fp1, *fp2, *sfp1 = NULL, *sfp2 = NULL;
+    size_t s;
+
+    if (len < sizeof(struct __freelist) - sizeof(size_t))
+        len = sizeof(struct __freelist) - sizeof(size_t);
+
+    // exact fit or smallest chunk larger than len
+    for (s = 0, fp1 = __flp, fp2 = NULL; fp1 != NULL; fp2 = fp1, fp1 = fp1->nx)
+    {
+        if (fp1->sz < len) continue;
+        if (fp1->sz == len)
+        {
+            if (fp2 != NULL) fp2->nx = fp1->nx;
+            else __flp = fp1->nx;
+            return &fp1->nx;
+        }
+        if (s == 0 || fp1->sz < s)
+        {
+            s = fp1->sz;
+            sfp1 = fp1;
+            sfp2 = fp2;
+        }
+    }
+
+    if (s != 0)
+    {
+        // too small to split: take it whole
+        if (s - len < sizeof(struct __freelist))
+        {
+            if (sfp2 != NULL) sfp2->nx = sfp1->nx;
+            else __flp = sfp1->nx;
+            return &sfp1->nx;
+        }
+        // allocate the upper part
+        char *cp = (char *)sfp1 + s - len;
+        sfp2 = (struct __freelist *)cp;
+        sfp2->sz = len;
+        sfp1->sz = s - len - sizeof(size_t);
+        return &sfp2->nx;
+    }
+
+    // extend the heap top
+    if (__brkval == NULL) __brkval = __malloc_heap_start;
+    char *cp = __malloc_heap_end;
+    if (cp <= __brkval) return NULL;
+    size_t avail = cp - __brkval;
+    if (avail >= len && avail >= len + sizeof(size_t))
+    {
+        fp1 = (struct __freelist *)__brkval;
+        __brkval += len + sizeof(size_t);
+        fp1->sz = len;
+        return &fp1->nx;
+    }
+
+    return NULL;
+}
+
+// avr-libc free.c
+void _ShimFree(void *p)
+{
+    if (p == NULL) return;
+    if (!_ShimAvrHeap(p))
+    {
+        free(p);
+        return;
+    }
+
+    struct __freelist *fp1, *fp2;
+    char *cpnew = (char *)p - sizeof(size_t);
+    struct __freelist *fpnew = (struct __freelist *)cpnew;
+    fpnew->nx = NULL;
+
+    if (__flp == NULL)
+    {
+        if ((char *)p + fpnew->sz == __brkval) __brkval = cpnew;
+        else __flp = fpnew;
+        return;
+    }
+
+    // insert sorted by address merging with the following chunk
+    for (fp1 = __flp, fp2 = NULL; fp1 != NULL; fp2 = fp1, fp1 = fp1->nx)
+    {
+        if (fp1 < fpnew) continue;
+        fpnew->nx = fp1;
+        if ((char *)&fpnew->nx + fpnew->sz == (char *)fp1)
+        {
+            fpnew->sz += fp1->sz + sizeof(size_t);
+            fpnew->nx = fp1->nx;
+        }
+        break;
+    }
+
+    if (fp2 == NULL)
+    {
+        __flp = fpnew;
+        return;
+    }
+
+    // merge with the previous chunk
+    fp2->nx = fpnew;
+    if ((char *)&fp2->nx + fp2->sz == cpnew)
+    {
+        fp2->sz += fpnew->sz + sizeof(size_t);
+        fp2->nx = fpnew->nx;
+    }
+
+    // give a topmost chunk back to the heap top
+    for (fp1 = __flp, fp2 = NULL; fp1->nx != NULL; fp2 = fp1, fp1 = fp1->nx)
+        ;
+    if ((char *)&fp1->nx + fp1->sz == __brkval)
+    {
+        if (fp2 == NULL) __flp = NULL;
+        else fp2->nx = NULL;
+        __brkval = (char *)fp1;
+    }
+}
+
+// arduino core millis counter ( wiring.c )
+volatile unsigned long timer0_millis = 0;
+
+//===========================================================================
+// time
+//===========================================================================
+
+static uint64_t _ShimNowUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static uint64_t _ShimStartUs = _ShimNowUs();
+
+unsigned long millis()
+{
+    return (unsigned long)((_ShimNowUs() - _ShimStartUs) / 1000) + timer0_millis;
+}
+
+unsigned long micros()
+{
+    return (unsigned long)(_ShimNowUs() - _ShimStartUs);
+}
+
+void delay(unsigned long ms)
+{
+    struct timespec ts;
+    ts.tv_sec = ms / 1000;
+    ts.tv_nsec = (ms % 1000) * 1000000L;
+    nanosleep(&ts, NULL);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    struct timespec ts;
+    ts.tv_sec = us / 1000000;
+    ts.tv_nsec = (us % 1000000) * 1000L;
+    nanosleep(&ts, NULL);
+}
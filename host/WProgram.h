@@ -0,0 +1,2 @@
+// Pre-1.0 core header name ( used when ARDUINO isn't defined ).
+#include "Arduino.h"
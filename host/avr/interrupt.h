@@ -0,0 +1,2 @@
+// Interrupt macros are in the host Arduino.h.
+#include "../Arduino.h"
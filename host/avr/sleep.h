@@ -0,0 +1,27 @@
+#ifndef _SEARCHATHING_ARDUINO_UTILS_HOST_AVR_SLEEP_H
+#define _SEARCHATHING_ARDUINO_UTILS_HOST_AVR_SLEEP_H
+
+// Sleep returns at once on host after calling the hook set into
+// _ShimSleepHook ( if any ) with the selected mode, eg. a test can fire
+// the watchdog isr from it to simulate the wake up.
+
+#include "../Arduino.h"
+
+#define SLEEP_MODE_IDLE 0
+#define SLEEP_MODE_PWR_DOWN 2
+
+extern uint8_t _ShimSleepMode;
+extern void (*_ShimSleepHook)(uint8_t mode);
+
+#define set_sleep_mode(mode) (_ShimSleepMode = (mode))
+#define sleep_enable()
+#define sleep_disable()
+#define sleep_cpu()                                 \
+    do                                              \
+    {                                               \
+        if (_ShimSleepHook != NULL)                 \
+            _ShimSleepHook(_ShimSleepMode);         \
+    } while (0)
+#define sleep_mode() sleep_cpu()
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef _SEARCHATHING_ARDUINO_UTILS_HOST_AVR_WDT_H
+#define _SEARCHATHING_ARDUINO_UTILS_HOST_AVR_WDT_H
+
+// Watchdog only updates the WDTCSR variable on host.
+
+#include "../Arduino.h"
+
+#define wdt_reset()
+#define wdt_disable() (WDTCSR = 0)
+
+#endif
@@ -0,0 +1,2 @@
+// avr core <new.h> ( placement new ).
+#include <new>
@@ -0,0 +1,11 @@
+#ifndef _SEARCHATHING_ARDUINO_UTILS_HOST_UTIL_ATOMIC_H
+#define _SEARCHATHING_ARDUINO_UTILS_HOST_UTIL_ATOMIC_H
+
+// Host is single threaded from the library point of view: atomic blocks
+// just run their body once.
+
+#define ATOMIC_RESTORESTATE
+#define ATOMIC_FORCEON
+#define ATOMIC_BLOCK(type) for (uint8_t _atomicOnce = 1; _atomicOnce; _atomicOnce = 0)
+
+#endif
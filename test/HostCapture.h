@@ -0,0 +1,17 @@
+#ifndef _SEARCHATHING_ARDUINO_UTILS_TEST_HOST_CAPTURE_H
+#define _SEARCHATHING_ARDUINO_UTILS_TEST_HOST_CAPTURE_H
+
+#include <string>
+
+#include "DPrint.h"
+
+// Returns DPrint output captured by the host sink since the last call.
+inline std::string TakeCapture()
+{
+    std::string res(SearchAThing::Arduino::DPrintHostCapture(),
+                    SearchAThing::Arduino::DPrintHostCaptureSize());
+    SearchAThing::Arduino::DPrintHostReset();
+    return res;
+}
+
+#endif
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include "ByteStream.h"
+#include "Util.h"
+
+using namespace SearchAThing::Arduino;
+
+TEST(ByteStream, Endian)
+{
+    byte buf[32];
+    ByteWriter w(buf, sizeof(buf));
+
+    w.WriteU16BE(0x1234);
+    w.WriteU16LE(0x1234);
+    w.WriteU24BE(0xabcdef);
+    w.WriteU24LE(0xabcdef);
+    w.WriteU32BE(0xdeadbeef);
+    w.WriteU32LE(0xdeadbeef);
+    w.WriteI16BE(-2);
+    w.WriteU64LE(0x0102030405060708ULL);
+    ASSERT_TRUE(w.Ok());
+    ASSERT_EQ(w.Size(), 28);
+
+    const byte expected[] = {
+        0x12, 0x34, 0x34, 0x12,
+        0xab, 0xcd, 0xef, 0xef, 0xcd, 0xab,
+        0xde, 0xad, 0xbe, 0xef, 0xef, 0xbe, 0xad, 0xde,
+        0xff, 0xfe,
+        0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01 };
+    EXPECT_EQ(memcmp(buf, expected, sizeof(expected)), 0);
+
+    // same layout as the Util helpers
+    EXPECT_EQ(BufReadUInt16_t(buf), 0x1234);
+    EXPECT_EQ(BufReadUInt32_t(buf + 10), 0xdeadbeefu);
+
+    ByteReader r(buf, w.Size());
+    EXPECT_EQ(r.ReadU16BE(), 0x1234);
+    EXPECT_EQ(r.ReadU16LE(), 0x1234);
+    EXPECT_EQ(r.ReadU24BE(), 0xabcdefu);
+    EXPECT_EQ(r.ReadU24LE(), 0xabcdefu);
+    EXPECT_EQ(r.ReadU32BE(), 0xdeadbeefu);
+    EXPECT_EQ(r.ReadU32LE(), 0xdeadbeefu);
+    EXPECT_EQ(r.ReadI16BE(), -2);
+    EXPECT_EQ(r.ReadU64LE(), 0x0102030405060708ULL);
+    EXPECT_TRUE(r.Ok());
+    EXPECT_EQ(r.Available(), 0);
+}
+
+TEST(ByteStream, Float)
+{
+    byte buf[8];
+    ByteWriter w(buf, sizeof(buf));
+    w.WriteFloatBE(-1.5f);
+    w.WriteFloatLE(3.25e-10f);
+
+    ByteReader r(buf, sizeof(buf));
+    EXPECT_EQ(r.ReadFloatBE(), -1.5f);
+    EXPECT_EQ(r.ReadFloatLE(), 3.25e-10f);
+    EXPECT_TRUE(r.Ok());
+}
+
+TEST(ByteStream, Overflow)
+{
+    byte buf[3] = { 0xaa, 0xaa, 0xaa };
+    ByteWriter w(buf, sizeof(buf));
+    w.WriteU16BE(1);
+    w.WriteU16BE(2); // doesn't fit: nothing written
+    w.WriteU8(3);    // error latched, cursor at end
+    EXPECT_FALSE(w.Ok());
+    EXPECT_EQ(buf[2], 0xaa);
+    EXPECT_EQ(w.Available(), 0);
+
+    ByteReader r(buf, sizeof(buf));
+    EXPECT_EQ(r.ReadU16BE(), 1);
+    EXPECT_EQ(r.ReadU32BE(), 0u);
+    EXPECT_FALSE(r.Ok());
+}
+
+TEST(ByteStream, Varint)
+{
+    const uint32_t values[] = { 0, 1, 127, 128, 300, 16383, 16384, 0x0fffffff, 0x10000000, 0xffffffff };
+    const uint8_t sizes[] = { 1, 1, 1, 2, 2, 2, 3, 4, 5, 5 };
+
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+    {
+        byte buf[5];
+        ByteWriter w(buf, sizeof(buf));
+        w.WriteVarint(values[i]);
+        ASSERT_TRUE(w.Ok());
+        EXPECT_EQ(w.Size(), sizes[i]) << values[i];
+
+        ByteReader r(buf, w.Size());
+        EXPECT_EQ(r.ReadVarint(), values[i]);
+        EXPECT_TRUE(r.Ok());
+    }
+
+    const int32_t svalues[] = { 0, -1, 1, -64, 64, 2147483647, -2147483647 - 1 };
+    for (auto v : svalues)
+    {
+        byte buf[5];
+        ByteWriter w(buf, sizeof(buf));
+        w.WriteSVarint(v);
+        ByteReader r(buf, w.Size());
+        EXPECT_EQ(r.ReadSVarint(), v);
+        EXPECT_TRUE(r.Ok());
+    }
+}
+
+TEST(ByteStream, VarintMalformed)
+{
+    // 5th byte with bits above bit 31
+    const byte over[] = { 0xff, 0xff, 0xff, 0xff, 0x1f };
+    ByteReader r1(over, sizeof(over));
+    EXPECT_EQ(r1.ReadVarint(), 0u);
+    EXPECT_FALSE(r1.Ok());
+
+    // largest valid 5th byte
+    const byte max[] = { 0xff, 0xff, 0xff, 0xff, 0x0f };
+    ByteReader r2(max, sizeof(max));
+    EXPECT_EQ(r2.ReadVarint(), 0xffffffffu);
+    EXPECT_TRUE(r2.Ok());
+
+    // more than 5 bytes
+    const byte longer[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x00 };
+    ByteReader r3(longer, sizeof(longer));
+    r3.ReadVarint();
+    EXPECT_FALSE(r3.Ok());
+
+    // truncated
+    const byte cut[] = { 0x80, 0x80 };
+    ByteReader r4(cut, sizeof(cut));
+    r4.ReadVarint();
+    EXPECT_FALSE(r4.Ok());
+}
+
+TEST(ByteStream, Blob)
+{
+    byte buf[16];
+    const byte data[] = { 1, 2, 3, 4 };
+    ByteWriter w(buf, sizeof(buf));
+    w.WriteBlob(data, sizeof(data));
+    w.WriteU8(9);
+
+    ByteReader r(buf, w.Size());
+    const byte *p;
+    ASSERT_EQ(r.ReadBlob(p), 4);
+    EXPECT_EQ(p, buf + 1);
+    EXPECT_EQ(memcmp(p, data, 4), 0);
+    EXPECT_EQ(r.ReadU8(), 9);
+    EXPECT_TRUE(r.Ok());
+
+    // length beyond the buffer
+    buf[0] = 100;
+    ByteReader bad(buf, w.Size());
+    EXPECT_EQ(bad.ReadBlob(p), 0);
+    EXPECT_EQ(p, nullptr);
+    EXPECT_FALSE(bad.Ok());
+}
@@ -0,0 +1,333 @@
+#include <gtest/gtest.h>
+
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "DCbor.h"
+#include "RAMStats.h"
+#include "Util.h"
+
+#include "HostCapture.h"
+
+using namespace SearchAThing::Arduino;
+
+// Minimal CBOR decoder ( subset written by DCbor ) rendering items in
+// RFC 8949 diagnostic notation, eg. {"a": [1, -2, 1.5, true, h'0102']}.
+// Sets `ok' false on malformed or truncated input.
+class CborDiag
+{
+    const std::string& in;
+    size_t pos = 0;
+
+    bool Byte(uint8_t& b)
+    {
+        if (pos >= in.size()) return ok = false;
+        b = in[pos++];
+        return true;
+    }
+
+    // argument of an item head with additional info `ai'
+    bool Arg(uint8_t ai, uint64_t& v)
+    {
+        if (ai < 24)
+        {
+            v = ai;
+            return true;
+        }
+        if (ai > 27) return ok = false;
+
+        uint8_t n = 1 << (ai - 24);
+        v = 0;
+        for (uint8_t i = 0; i < n; ++i)
+        {
+            uint8_t b;
+            if (!Byte(b)) return false;
+            v = (v << 8) | b;
+        }
+        return true;
+    }
+
+    bool Break()
+    {
+        if (pos < in.size() && (uint8_t)in[pos] == 0xff)
+        {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+
+public:
+    bool ok = true;
+
+    CborDiag(const std::string& _in) : in(_in) {}
+
+    bool Done() const { return ok && pos == in.size(); }
+
+    std::string Item()
+    {
+        uint8_t b;
+        if (!Byte(b)) return "";
+
+        uint8_t major = b >> 5;
+        uint8_t ai = b & 0x1f;
+        bool indef = ai == 31 && (major == DCBOR_ARRAY || major == DCBOR_MAP);
+
+        uint64_t v = 0;
+        if (!indef && major != DCBOR_SIMPLE && !Arg(ai, v)) return "";
+
+        char s[32];
+        std::string res;
+
+        switch (major)
+        {
+        case DCBOR_UINT:
+            snprintf(s, sizeof(s), "%llu", (unsigned long long)v);
+            return s;
+
+        case DCBOR_NINT:
+            snprintf(s, sizeof(s), "-%llu", (unsigned long long)v + 1);
+            return s;
+
+        case DCBOR_BYTES:
+        case DCBOR_TEXT:
+            if (v > in.size() - pos)
+            {
+                ok = false;
+                return "";
+            }
+            if (major == DCBOR_TEXT)
+                res = "\"" + in.substr(pos, v) + "\"";
+            else
+            {
+                res = "h'";
+                for (uint64_t i = 0; i < v; ++i)
+                {
+                    snprintf(s, sizeof(s), "%02x", (uint8_t)in[pos + i]);
+                    res += s;
+                }
+                res += "'";
+            }
+            pos += v;
+            return res;
+
+        case DCBOR_ARRAY:
+        case DCBOR_MAP:
+            res = major == DCBOR_MAP ? "{" : "[";
+            if (indef) res += "_ ";
+            for (uint64_t i = 0; ok && (indef ? !Break() : i < v); ++i)
+            {
+                if (i > 0) res += ", ";
+                res += Item();
+                if (major == DCBOR_MAP) res += ": " + Item();
+                if (indef && pos >= in.size()) ok = false;
+            }
+            res += major == DCBOR_MAP ? "}" : "]";
+            return res;
+
+        case DCBOR_SIMPLE:
+            if (ai == 20) return "false";
+            if (ai == 21) return "true";
+            if (ai == 22) return "null";
+            if (ai == 26)
+            {
+                uint64_t bits;
+                if (!Arg(ai, bits)) return "";
+                uint32_t b32 = bits;
+                float f;
+                memcpy(&f, &b32, 4);
+                snprintf(s, sizeof(s), "%g", f);
+                return s;
+            }
+            break;
+        }
+
+        ok = false;
+        return "";
+    }
+};
+
+// decodes the whole capture as a sequence of items
+static std::string Decode(const std::string& cbor)
+{
+    CborDiag d(cbor);
+    std::string res;
+    while (d.ok && !d.Done())
+    {
+        if (!res.empty()) res += " ";
+        res += d.Item();
+    }
+    EXPECT_TRUE(d.Done()) << res;
+    return res;
+}
+
+TEST(DCbor, UIntShortestHead)
+{
+    TakeCapture();
+
+    DCborUInt(23);
+    EXPECT_EQ(TakeCapture(), std::string("\x17", 1));
+    DCborUInt(24);
+    EXPECT_EQ(TakeCapture(), std::string("\x18\x18", 2));
+    DCborUInt(256);
+    EXPECT_EQ(TakeCapture(), std::string("\x19\x01\x00", 3));
+    DCborUInt(65536);
+    EXPECT_EQ(TakeCapture(), std::string("\x1a\x00\x01\x00\x00", 5));
+
+    DCborUInt(0); DCborUInt(255); DCborUInt(65535); DCborUInt(UINT32_MAX);
+    EXPECT_EQ(Decode(TakeCapture()), "0 255 65535 4294967295");
+}
+
+TEST(DCbor, Int)
+{
+    TakeCapture();
+
+    DCborInt(-1);
+    EXPECT_EQ(TakeCapture(), std::string("\x20", 1));
+
+    DCborInt(0); DCborInt(-24); DCborInt(-25); DCborInt(-1000);
+    DCborInt(INT32_MAX); DCborInt(INT32_MIN);
+    EXPECT_EQ(Decode(TakeCapture()), "0 -24 -25 -1000 2147483647 -2147483648");
+}
+
+TEST(DCbor, Simple)
+{
+    TakeCapture();
+
+    DCborFloat(21.5f);
+    EXPECT_EQ(TakeCapture(), std::string("\xfa\x41\xac\x00\x00", 5));
+
+    DCborFloat(-0.125f); DCborBool(true); DCborBool(false); DCborNull();
+    EXPECT_EQ(Decode(TakeCapture()), "-0.125 true false null");
+}
+
+TEST(DCbor, Strings)
+{
+    TakeCapture();
+
+    const byte bytes[] = { 0x01, 0xab, 0x00 };
+    DCborBytes(bytes, sizeof(bytes));
+    DCborStr("abc");
+    DCborStrn("abcdef", 2);
+    DCborF(F("key"));
+    DCborStr("");
+    EXPECT_EQ(Decode(TakeCapture()), "h'01ab00' \"abc\" \"ab\" \"key\" \"\"");
+
+    // 24 chars need a 1 byte length
+    DCborStr("012345678901234567890123");
+    std::string c = TakeCapture();
+    EXPECT_EQ(c.size(), 2u + 24);
+    EXPECT_EQ((uint8_t)c[0], 0x78);
+}
+
+TEST(DCbor, KeyUInt)
+{
+    TakeCapture();
+
+    DCborMap(2);
+    DCborKeyUInt(0, 5);
+    DCborKeyUInt(23, 1000);
+    std::string c = TakeCapture();
+    EXPECT_EQ(c, std::string("\xa2\x00\x05\x17\x19\x03\xe8", 7));
+    EXPECT_EQ(Decode(c), "{0: 5, 23: 1000}");
+}
+
+TEST(DCbor, Containers)
+{
+    TakeCapture();
+
+    DCborMap(2);
+    DCborF(F("blk")); DCborUInt(312);
+    DCborF(F("v"));
+    DCborArray(3); DCborInt(-2); DCborFloat(1.5f); DCborBool(true);
+    EXPECT_EQ(Decode(TakeCapture()), "{\"blk\": 312, \"v\": [-2, 1.5, true]}");
+
+    DCborMapBegin();
+    DCborF(F("a"));
+    DCborArrayBegin(); DCborUInt(1); DCborUInt(2); DCborBreak();
+    DCborF(F("b")); DCborNull();
+    DCborBreak();
+    EXPECT_EQ(Decode(TakeCapture()), "{_ \"a\": [_ 1, 2], \"b\": null}");
+}
+
+TEST(DCbor, Truncated)
+{
+    TakeCapture();
+
+    DCborStr("abcdef");
+    std::string c = TakeCapture();
+    c.resize(c.size() - 1);
+
+    CborDiag d(c);
+    d.Item();
+    EXPECT_FALSE(d.ok);
+}
+
+static RAMStats SampleStats()
+{
+    RAMStats s;
+    s.heapSize = 412;
+    s.heapHighWater = 530;
+    s.freeListCount = 3;
+    s.freeListSum = 96;
+    s.freeListMax = 48;
+    s.heapTopFree = 1210;
+    s.freeMax = 1210;
+    s.fragmentation = 7;
+    s.stackSize = 138;
+    s.stackHighWater = 301;
+    s.neverUsed = 873;
+    return s;
+}
+
+TEST(DCbor, RAMStats)
+{
+    TakeCapture();
+
+    PrintRAMStatsCbor(SampleStats());
+    EXPECT_EQ(Decode(TakeCapture()),
+        "{0: 412, 1: 530, 2: 3, 3: 96, 4: 48, 5: 1210, 6: 1210, 7: 7, "
+        "8: 138, 9: 301, 10: 873}");
+}
+
+TEST(DCbor, RAMLayout)
+{
+    TakeCapture();
+
+    PrintRAMLayoutCbor();
+    std::string diag = Decode(TakeCapture());
+
+    EXPECT_EQ(diag.find("{0: 128, 1: "), 0u) << diag;
+    EXPECT_NE(diag.find(", 9: 2047, "), std::string::npos) << diag;
+    EXPECT_NE(diag.find(", 11: 2303, 12: 0, 13: [_ ]}"), std::string::npos) << diag;
+}
+
+// Wire size of CBOR telemetry against the text printed by PrintRAMLayout
+// and PrintRAMStats ( sizes recorded as test properties ). Host addresses
+// are 8 hex digits in the PrintRAMLayout text against 4 on avr.
+TEST(DCbor, SizeAgainstText)
+{
+    TakeCapture();
+
+    PrintRAMLayout();
+    size_t layoutText = TakeCapture().size();
+    PrintRAMLayoutCbor();
+    size_t layoutCbor = TakeCapture().size();
+
+    RAMStats stats = SampleStats();
+    PrintRAMStats(stats);
+    size_t statsText = TakeCapture().size();
+    PrintRAMStatsCbor(stats);
+    size_t statsCbor = TakeCapture().size();
+
+    RecordProperty("layout_text", (int)layoutText);
+    RecordProperty("layout_cbor", (int)layoutCbor);
+    RecordProperty("stats_text", (int)statsText);
+    RecordProperty("stats_cbor", (int)statsCbor);
+    printf("PrintRAMLayout text %zu cbor %zu ; PrintRAMStats text %zu cbor %zu\n",
+        layoutText, layoutCbor, statsText, statsCbor);
+
+    EXPECT_LT(layoutCbor, layoutText);
+    EXPECT_LT(statsCbor, statsText);
+}
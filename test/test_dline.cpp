@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include "DLine.h"
+
+#include "HostCapture.h"
+
+using namespace SearchAThing::Arduino;
+
+static std::string Line(const DLine<16>& l)
+{
+    return std::string(l.Data(), l.Size());
+}
+
+TEST(DLine, Append)
+{
+    DLine<32> l;
+    l.Flash(F("t=")).UInt32(1234).Char(' ').Int16(-5, 4, '0').Char(' ').Float(2.5f, 1);
+
+    TakeCapture();
+    l.Commitln();
+    EXPECT_EQ(TakeCapture(), "t=1234 -005 2.5\n");
+    EXPECT_EQ(l.Size(), 0);
+    EXPECT_FALSE(l.Truncated());
+}
+
+TEST(DLine, StringIsCut)
+{
+    DLine<16> l;
+    l.Str("0123456789").Str("abcdefghij").Char('x');
+
+    EXPECT_EQ(Line(l), "0123456789abcdef");
+    EXPECT_TRUE(l.Truncated());
+}
+
+TEST(DLine, NumberIsDropped)
+{
+    DLine<16> l;
+    l.Str("0123456789").UInt32(1234567).Char('x');
+
+    EXPECT_EQ(Line(l), "0123456789");
+    EXPECT_TRUE(l.Truncated());
+}
+
+TEST(DLine, FloatIsDropped)
+{
+    DLine<16> l;
+    l.Str("0123456789").Float(3.14159f, 2);
+    EXPECT_EQ(Line(l), "01234567893.14");
+    EXPECT_FALSE(l.Truncated());
+
+    // "123.46" doesn't fit the 2 chars left: nothing is appended
+    l.Float(123.456f, 2).Char('x');
+    EXPECT_EQ(Line(l), "01234567893.14");
+    EXPECT_TRUE(l.Truncated());
+}
+
+TEST(DLine, FlushWhenFull)
+{
+    DLine<8> l(true);
+    TakeCapture();
+
+    l.Str("0123456789").Int16(-42, 12, '0').Flash(F(" ok")).Float(1.5f, 1);
+    EXPECT_FALSE(l.Truncated());
+    l.Commitln();
+    EXPECT_EQ(TakeCapture(), "0123456789-00000000042 ok1.5\n");
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include "DPrint.h"
+
+#include "HostCapture.h"
+
+using namespace SearchAThing::Arduino;
+
+TEST(DPrint, Chars)
+{
+    TakeCapture();
+
+    DPrintChar('a');
+    DPrintCharX('-', 3);
+    DPrintBool(true);
+    DPrintBool(false);
+    DPrintByte(200);
+    DPrintln();
+    EXPECT_EQ(TakeCapture(), "a---10200\n");
+}
+
+TEST(DPrint, Strings)
+{
+    TakeCapture();
+
+    DPrintStr("abc");
+    DPrintStrn("defgh", 2);
+    DPrintF(F("flash"));
+    DPrintFn(F("flash"), 3);
+    DPrintStrln("!");
+    EXPECT_EQ(TakeCapture(), "abcdeflashfla!\n");
+}
+
+TEST(DPrint, Integers)
+{
+    TakeCapture();
+
+    DPrintUInt16(0);
+    DPrintChar(' ');
+    DPrintUInt16(65535);
+    DPrintChar(' ');
+    DPrintInt16(-32768);
+    DPrintChar(' ');
+    DPrintUInt32(4294967295UL);
+    DPrintChar(' ');
+    DPrintInt32(-2147483647L - 1);
+    EXPECT_EQ(TakeCapture(), "0 65535 -32768 4294967295 -2147483648");
+}
+
+TEST(DPrint, IntegersPadded)
+{
+    TakeCapture();
+
+    DPrintUInt16(42, 5, '0');
+    DPrintChar('|');
+    DPrintUInt16(42, 5);
+    DPrintChar('|');
+    DPrintInt16(-42, 6, '0');
+    DPrintChar('|');
+    DPrintInt32(-42, 6);
+    DPrintChar('|');
+    // width smaller than digits doesn't cut
+    DPrintUInt32(123456, 2, '0');
+    EXPECT_EQ(TakeCapture(), "00042|   42|-00042|   -42|123456");
+}
+
+TEST(DPrint, Float)
+{
+    TakeCapture();
+
+    DPrintFloat(3.14159f);
+    DPrintChar(' ');
+    DPrintFloat(-0.5f, 3);
+    DPrintChar(' ');
+    DPrintFloatln(2.5f, 0);
+    EXPECT_EQ(TakeCapture(), "3.14 -0.500 3\n");
+}
+
+TEST(DPrint, Hex)
+{
+    TakeCapture();
+
+    DPrintHex((byte)0xab);
+    DPrintChar(' ');
+    DPrintHex((uint16_t)0x1f, true);
+    DPrintChar(' ');
+    DPrintHex(0xdeadbeefUL, true);
+    DPrintChar(' ');
+    byte buf[] = { 0x30, 0x31, 0x32 };
+    DPrintHexBytes(buf, 3);
+    DPrintChar(' ');
+    DPrintBytes(buf, 3);
+    EXPECT_EQ(TakeCapture(), "ab 0x001f 0xdeadbeef 30-31-32 48.49.50");
+}
+
+TEST(DPrint, HexDump)
+{
+    TakeCapture();
+
+    byte buf[20];
+    for (int i = 0; i < 20; ++i) buf[i] = 0x30 + i;
+
+    DPrintHex(buf, 3);
+    EXPECT_EQ(TakeCapture(), "303132");
+
+    DPrintHex(buf, 20, true, true);
+    EXPECT_EQ(TakeCapture(),
+        "0000:   30 31 32 33 34 35 36 37  38 39 3a 3b 3c 3d 3e 3f  |0123456789:;<=>?|\n"
+        "0010:   40 41 42 43                                       |@ABC|");
+}
+
+TEST(DPrint, Log)
+{
+    TakeCapture();
+
+    DLogln(F("a="), 1, ' ', -2L, ' ', 1.5f, ' ', true, ' ', "s", ' ', 'c');
+    EXPECT_EQ(TakeCapture(), "a=1 -2 1.50 1 s c\n");
+}
+
+TEST(DPrint, LogLevels)
+{
+    TakeCapture();
+
+    DLogSetLevel(DLOG_WARN);
+    DLOG_IF(DLOG_INFO, DLOG_CH_USER) DLog(F("info"));
+    DLOG_IF(DLOG_ERROR, DLOG_CH_USER) DLog(F("error"));
+    DLogSetLevel(DLOG_LEVEL);
+
+    DLogSetChannels(DLOG_CH_MEM);
+    DLOG_IF(DLOG_ERROR, DLOG_CH_USER) DLog(F("user"));
+    DLogSetChannels(DLOG_CHANNELS);
+
+    EXPECT_EQ(TakeCapture(), "error");
+}
+
+TEST(DPrint, LogIfElse)
+{
+    TakeCapture();
+
+    // else belongs to the outer if, not to the one of DLOG_IF
+    for (int i = 0; i < 2; ++i)
+        if (i == 0)
+            DLOG_IF(DLOG_ERROR, DLOG_CH_USER) DLog(F("a"));
+        else
+            DLog(F("b"));
+
+    EXPECT_EQ(TakeCapture(), "ab");
+}
+
+TEST(DPrint, LogLongLine)
+{
+    TakeCapture();
+
+    // lines longer than DLOG_LINE_SIZE are sent in chunks without losing chars
+    std::string s(DLOG_LINE_SIZE - 3, 'x');
+    DLogln(s.c_str(), 1234567890UL, F("-flash-"), s.c_str(), -1.25f);
+    EXPECT_EQ(TakeCapture(), s + "1234567890-flash-" + s + "-1.25\n");
+
+    std::string full(DLOG_LINE_SIZE, 'y');
+    DLogln(full.c_str());
+    EXPECT_EQ(TakeCapture(), full + "\n");
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <stdio.h>
+
+#include "DPrint.h"
+#include "Util.h"
+
+#include "HostCapture.h"
+
+using namespace SearchAThing::Arduino;
+
+// integer printers checked against printf
+
+static std::string Printf(const char *fmt, long long v, int width = 0)
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), fmt, width, v);
+    return buf;
+}
+
+TEST(DPrintInt, Exhaustive16)
+{
+    TakeCapture();
+
+    for (uint32_t i = 0; i <= 0xffff; ++i)
+    {
+        uint16_t u = i;
+        int16_t s = (int16_t)u;
+
+        DPrintUInt16(u);
+        ASSERT_EQ(TakeCapture(), Printf("%*lld", u)) << u;
+
+        DPrintUInt16(u, 7, '0');
+        ASSERT_EQ(TakeCapture(), Printf("%0*lld", u, 7)) << u;
+
+        DPrintInt16(s);
+        ASSERT_EQ(TakeCapture(), Printf("%*lld", s)) << s;
+
+        DPrintInt16(s, 7);
+        ASSERT_EQ(TakeCapture(), Printf("%*lld", s, 7)) << s;
+
+        DPrintInt16(s, 7, '0');
+        ASSERT_EQ(TakeCapture(), Printf("%0*lld", s, 7)) << s;
+
+        char buf[5];
+        ASSERT_EQ(std::string(buf, UInt16ToDec(buf, u)), Printf("%*lld", u)) << u;
+    }
+}
+
+TEST(DPrintInt, Random32)
+{
+    TakeCapture();
+
+    uint32_t seed = 1;
+    for (int i = 0; i < 200000; ++i)
+    {
+        seed = seed * 1664525UL + 1013904223UL;
+        // spread over all magnitudes
+        uint32_t u = seed >> (i % 32);
+        int32_t s = (int32_t)(i & 1 ? u : seed);
+        uint8_t width = i % 13;
+
+        DPrintUInt32(u, width);
+        ASSERT_EQ(TakeCapture(), Printf("%*lld", u, width)) << u;
+
+        DPrintUInt32(u, width, '0');
+        ASSERT_EQ(TakeCapture(), Printf("%0*lld", u, width)) << u;
+
+        DPrintInt32(s, width);
+        ASSERT_EQ(TakeCapture(), Printf("%*lld", s, width)) << s;
+
+        DPrintInt32(s, width, '0');
+        ASSERT_EQ(TakeCapture(), Printf("%0*lld", s, width)) << s;
+    }
+
+    for (int32_t s : { 0L, 1L, -1L, 2147483647L, -2147483647L - 1 })
+    {
+        DPrintInt32(s, 12, '0');
+        ASSERT_EQ(TakeCapture(), Printf("%0*lld", s, 12)) << s;
+    }
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include <map>
+
+#include "DPrint.h"
+#include "DPrintTok.h"
+
+#include "dtokdecode.h"
+
+#include "HostCapture.h"
+
+using namespace SearchAThing::Arduino;
+
+// Records are decoded with the dtokdecode logic looking up strings by
+// the low 16 bits of their host address ( as sent by DPrintTok ).
+class DPrintTokTest : public ::testing::Test
+{
+protected:
+    std::map<uint32_t, std::string> strings;
+
+    const __FlashStringHelper *Str(const __FlashStringHelper *s)
+    {
+        strings[(uint16_t)(size_t)s] = reinterpret_cast<const char *>(s);
+        return s;
+    }
+
+    std::string Decode()
+    {
+        auto raw = TakeCapture();
+        auto lookup = [this](uint32_t addr) { return strings.at(addr); };
+        return DTokDecode(lookup, (const uint8_t *)raw.data(), raw.size());
+    }
+
+    void SetUp() override { TakeCapture(); }
+};
+
+TEST_F(DPrintTokTest, Types)
+{
+    auto a = Str(F("a="));
+    auto b = Str(F(" b="));
+    auto c = Str(F(" c="));
+    auto d = Str(F(" d="));
+    auto e = Str(F(" e="));
+    auto f = Str(F(" f="));
+    auto g = Str(F(" end"));
+
+    DPrintTok(a, (byte)200);
+    DPrintTok(b, (uint16_t)65535);
+    DPrintTok(c, (int16_t)-32768);
+    DPrintTok(d, (uint32_t)4294967295UL);
+    DPrintTok(e, (int32_t)-2147483647L - 1);
+    DPrintTok(f, 21.5f, 1);
+    DPrintTokln(g);
+
+    EXPECT_EQ(Decode(), "a=200 b=65535 c=-32768 d=4294967295 e=-2147483648 f=21.5 end\n");
+}
+
+// Same values printed with DPrint and with DPrintTok decode to the same
+// text ( plain text between records is passed through ).
+TEST_F(DPrintTokTest, MatchesDPrint)
+{
+    auto t = Str(F("t="));
+    auto v = Str(F(" v="));
+    auto n = Str(F(" n="));
+
+    uint32_t seed = 7;
+    for (int i = 0; i < 1000; ++i)
+    {
+        seed = seed * 1664525UL + 1013904223UL;
+        uint32_t u = seed >> (i % 32);
+        int16_t s = (int16_t)seed;
+        float x = (int32_t)seed / 1024.0f;
+        int prec = i % 8;
+
+        DPrintStr("> ");
+        DPrintF(t);
+        DPrintUInt32(u);
+        DPrintF(v);
+        DPrintFloat(x, prec);
+        DPrintF(n);
+        DPrintInt16ln(s);
+        auto expected = TakeCapture();
+
+        DPrintStr("> ");
+        DPrintTok(t, u);
+        DPrintTok(v, x, prec);
+        DPrintTokln(n, s);
+        ASSERT_EQ(Decode(), expected);
+    }
+}
+
+// Floats from 2^32 up are printed by the device in exponent form, nan and
+// inf with its own spelling.
+TEST_F(DPrintTokTest, FloatSpecial)
+{
+    auto v = Str(F(" "));
+
+    const float values[] = { 4294967296.0f, 1e12f, -9.9999e10f, 3.4e38f,
+        NAN, INFINITY, -INFINITY, -0.0f };
+    for (float x : values)
+    {
+        DPrintStr(" ");
+        DPrintFloat(x, 2);
+    }
+    auto expected = TakeCapture();
+    EXPECT_EQ(expected, " 4.29e+09 1.00e+12 -1.00e+11 3.40e+38 nan inf -inf -0.00");
+
+    for (float x : values)
+        DPrintTok(v, x, 2);
+    EXPECT_EQ(Decode(), expected);
+}
+
+TEST_F(DPrintTokTest, Garbage)
+{
+    // truncated record and unknown type are passed through as text
+    const uint8_t raw[] = { 'x', DTOK_SYNC, 0, 0, 0x0f, 'y', DTOK_SYNC, 0 };
+    auto lookup = [](uint32_t) { return std::string("?"); };
+    EXPECT_EQ(DTokDecode(lookup, raw, sizeof(raw)), std::string((const char *)raw, sizeof(raw)));
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "Idle.h"
+
+#include <avr/sleep.h>
+
+using namespace SearchAThing::Arduino;
+
+extern volatile unsigned long timer0_millis;
+
+// watchdog isr defined by Idle.cpp
+extern "C" void WDT_vect(void);
+
+// power-down sleeps seen by the hook: watchdog timeout prescaler
+static std::vector<uint8_t> steps;
+
+// wake up by the watchdog ( true ) or by another interrupt
+static bool wdtWakes;
+
+static void SleepHook(uint8_t mode)
+{
+    ASSERT_EQ(mode, SLEEP_MODE_PWR_DOWN);
+    ASSERT_TRUE(WDTCSR & _BV(WDIE));
+    ASSERT_FALSE(WDTCSR & _BV(WDE)); // interrupt mode, no reset
+
+    steps.push_back((WDTCSR & 7) | ((WDTCSR & _BV(WDP3)) ? 8 : 0));
+    if (wdtWakes) WDT_vect();
+}
+
+class IdleTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        steps.clear();
+        wdtWakes = true;
+        timer0_millis = 0;
+        UCSR0B = 0;
+        TCCR0A = TCCR1A = TCCR2A = 0;
+        TIMSK1 = TIMSK2 = 0;
+        _ShimSleepHook = SleepHook;
+    }
+
+    void TearDown() override { _ShimSleepHook = NULL; }
+};
+
+TEST_F(IdleTest, WdtSteps)
+{
+    // 4000 + 2000 + 1000 + 500 + 250 + 125 + 64 + 16 ; 3ms left to idle mode
+    unsigned long slept = IdleFor(7958);
+
+    std::vector<uint8_t> expected = { 8, 7, 6, 5, 4, 3, 2, 0 };
+    EXPECT_EQ(steps, expected);
+    EXPECT_EQ(timer0_millis, 7955ul);
+    EXPECT_GE(slept, 7958ul);
+    EXPECT_EQ(WDTCSR, 0); // disabled by the isr
+}
+
+TEST_F(IdleTest, ShortIntervalStaysIdle)
+{
+    // below the shortest watchdog step
+    unsigned long slept = IdleFor(15);
+
+    EXPECT_TRUE(steps.empty());
+    EXPECT_EQ(timer0_millis, 0ul);
+    EXPECT_GE(slept, 15ul);
+}
+
+TEST_F(IdleTest, NotDeep)
+{
+    IdleFor(20, false);
+
+    EXPECT_TRUE(steps.empty());
+    EXPECT_EQ(timer0_millis, 0ul);
+}
+
+TEST_F(IdleTest, LongIntervalClamped)
+{
+    // eg. SScheduler::Run with no tasks
+    unsigned long slept = IdleFor((unsigned long)-1);
+
+    std::vector<uint8_t> expected = { 9 };
+    EXPECT_EQ(steps, expected);
+    EXPECT_EQ(timer0_millis, IDLE_MAX_MS);
+    EXPECT_EQ(slept, IDLE_MAX_MS);
+}
+
+TEST_F(IdleTest, UartReceiveStaysIdle)
+{
+    UCSR0B = _BV(RXEN0);
+    IdleFor(20);
+
+    EXPECT_TRUE(steps.empty());
+    EXPECT_EQ(timer0_millis, 0ul);
+}
+
+TEST_F(IdleTest, PwmStaysIdle)
+{
+    TCCR2A = _BV(COM2B1);
+    IdleFor(20);
+    EXPECT_TRUE(steps.empty());
+
+    // timer1 interrupt ( eg. Servo )
+    TCCR2A = 0;
+    TIMSK1 = 2;
+    IdleFor(20);
+    EXPECT_TRUE(steps.empty());
+
+    TIMSK1 = 0;
+    IdleFor(20);
+    EXPECT_EQ(steps.size(), 1u);
+}
+
+TEST_F(IdleTest, InterruptedWakeUp)
+{
+    // another interrupt ends the sleep: partial step not accounted
+    wdtWakes = false;
+    unsigned long slept = IdleFor(4000);
+
+    std::vector<uint8_t> expected = { 8 };
+    EXPECT_EQ(steps, expected);
+    EXPECT_EQ(timer0_millis, 0ul);
+    EXPECT_EQ(slept, 0ul);
+    EXPECT_EQ(WDTCSR, 0);
+}
+
+TEST_F(IdleTest, Stats)
+{
+    IdleStatsReset();
+    IdleFor(2000);
+
+    EXPECT_GE(IdleGetStats().slept, 2000ul);
+    EXPECT_LT(IdleDutyCycle(), 5);
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "SList.h"
+
+using namespace SearchAThing::Arduino;
+
+TEST(SList, AddGetRemove)
+{
+    SList<int> l;
+
+    for (int i = 0; i < 10; ++i) ASSERT_NE(l.Add(i), nullptr);
+    EXPECT_EQ(l.Size(), 10);
+
+    for (int i = 0; i < 10; ++i) EXPECT_EQ(l.Get(i), i);
+
+    l.Remove(0);
+    l.Remove(8); // last
+    l.Remove(3);
+    l.Remove(100); // out of bounds: no-op
+
+    int expected[] = { 1, 2, 3, 5, 6, 7, 8 };
+    ASSERT_EQ(l.Size(), 7);
+    for (int i = 0; i < 7; ++i) EXPECT_EQ(l.Get(i), expected[i]);
+
+    EXPECT_EQ(l.GetNode(-1), nullptr);
+    EXPECT_EQ(l.GetNode(7), nullptr);
+
+    l.Clear();
+    EXPECT_EQ(l.Size(), 0);
+    EXPECT_EQ(l.begin(), l.end());
+}
+
+TEST(SList, CursorAfterRemove)
+{
+    SList<int> l;
+    for (int i = 0; i < 5; ++i) l.Add(i);
+
+    // cursor left at idx 3 then removing before it must not reuse it
+    EXPECT_EQ(l.Get(3), 3);
+    l.Remove(1);
+    EXPECT_EQ(l.Get(2), 3);
+    EXPECT_EQ(l.Get(3), 4);
+    EXPECT_EQ(l.Get(1), 2);
+}
+
+TEST(SList, Iterate)
+{
+    SList<int> l;
+    for (int i = 0; i < 5; ++i) l.Add(i);
+
+    int sum = 0;
+    for (auto& x : l) sum += x;
+    EXPECT_EQ(sum, 10);
+}
+
+TEST(SList, EmplaceCopyMove)
+{
+    SList<std::string> l;
+    l.Emplace(3, 'x');
+    std::string s("abc");
+    l.Add(s);
+    l.Add(std::string("moved"));
+
+    EXPECT_EQ(l.Get(0), "xxx");
+    EXPECT_EQ(l.Get(1), "abc");
+    EXPECT_EQ(l.Get(2), "moved");
+
+    SList<std::string> copy(l);
+    EXPECT_EQ(copy.Size(), 3);
+    EXPECT_EQ(copy.Get(2), "moved");
+
+    SList<std::string> moved(SMove(l));
+    EXPECT_EQ(moved.Size(), 3);
+    EXPECT_EQ(l.Size(), 0);
+
+    copy = copy;
+    EXPECT_EQ(copy.Size(), 3);
+}
+
+TEST(SList, PoolExhaustion)
+{
+    typedef SListPool<int, 4, 1> Pool;
+    SList<int, Pool> l;
+
+    for (int i = 0; i < 4; ++i) ASSERT_NE(l.Add(i), nullptr);
+    EXPECT_EQ(Pool::Available(), 0);
+    EXPECT_EQ(l.Add(4), nullptr);
+    EXPECT_EQ(l.Size(), 4);
+
+    l.Remove(1);
+    EXPECT_EQ(Pool::Available(), 1);
+    EXPECT_NE(l.Add(5), nullptr);
+    EXPECT_EQ(l.Get(3), 5);
+}
+
+TEST(SList, CopyPoolExhaustion)
+{
+    typedef SListPool<int, 5, 3> Pool;
+    SList<int, Pool> a, b;
+    a.Add(1); a.Add(2);
+    b.Add(3); b.Add(4);
+
+    // copy doesn't fit beside current nodes: target unchanged
+    a = b;
+    EXPECT_EQ(a.Size(), 2);
+    EXPECT_EQ(a.Get(0), 1);
+    EXPECT_EQ(a.Get(1), 2);
+    EXPECT_EQ(Pool::Available(), 1);
+
+    b.Remove(1);
+    SList<int, Pool> c;
+    c.Add(7);
+    a = c;
+    EXPECT_EQ(a.Size(), 1);
+    EXPECT_EQ(a.Get(0), 7);
+    EXPECT_EQ(Pool::Available(), 2);
+
+    // copy constructor out of memory: empty list
+    a.Add(8);
+    a.Add(9);
+    SList<int, Pool> d(b);
+    EXPECT_EQ(d.Size(), 0);
+    EXPECT_EQ(Pool::Available(), 0);
+}
+
+TEST(SList, AllocTrace)
+{
+    typedef SListTracedAllocator<int, SListPool<int, 3, 2>, 7> Traced;
+    const uint16_t node = sizeof(SListNode<int>);
+
+    SAllocTrace<7>::Reset();
+    SList<int, Traced> l;
+    for (int i = 0; i < 3; ++i) l.Add(i);
+    EXPECT_EQ(l.Add(3), nullptr); // pool full
+
+    SAllocStats& s = SAllocTrace<7>::Stats();
+    EXPECT_EQ(s.allocs, 3u);
+    EXPECT_EQ(s.frees, 0u);
+    EXPECT_EQ(s.failures, 1u);
+    EXPECT_EQ(s.liveBytes, 3 * node);
+    EXPECT_EQ(s.peakBytes, 3 * node);
+
+    l.Remove(0);
+    EXPECT_EQ(s.frees, 1u);
+    EXPECT_EQ(s.liveBytes, 2 * node);
+    EXPECT_EQ(s.peakBytes, 3 * node);
+
+    l.Add(4);
+    l.Clear();
+    EXPECT_EQ(s.allocs, 4u);
+    EXPECT_EQ(s.frees, 4u);
+    EXPECT_EQ(s.liveBytes, 0);
+    EXPECT_EQ(s.peakBytes, 3 * node);
+}
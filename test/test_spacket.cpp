@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include "SPacket.h"
+#include "Util.h"
+
+using namespace SearchAThing::Arduino;
+
+struct Msg
+{
+    uint16_t id;
+    int32_t temp;
+    float v;
+    bool on;
+    int8_t delta;
+    uint64_t stamp;
+    uint32_t le;
+};
+
+typedef SPacket<SFIELD(Msg, id), SFIELD(Msg, temp), SFIELD(Msg, v), SFIELD(Msg, on),
+    SFIELD(Msg, delta), SFIELD(Msg, stamp), SFIELD_LE(Msg, le)> MsgPacket;
+
+static_assert(MsgPacket::WireSize == 2 + 4 + 4 + 1 + 1 + 8 + 4, "wire size");
+
+static Msg Sample()
+{
+    Msg m;
+    m.id = 0x1234;
+    m.temp = -2;
+    m.v = 1.5f;
+    m.on = true;
+    m.delta = -3;
+    m.stamp = 0x0102030405060708ULL;
+    m.le = 0xdeadbeef;
+    return m;
+}
+
+TEST(SPacket, Layout)
+{
+    byte buf[MsgPacket::WireSize];
+    MsgPacket::Encode(buf, Sample());
+
+    const byte expected[] = {
+        0x12, 0x34,
+        0xff, 0xff, 0xff, 0xfe,
+        0x3f, 0xc0, 0x00, 0x00,
+        0x01,
+        0xfd,
+        0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+        0xef, 0xbe, 0xad, 0xde };
+    ASSERT_EQ(sizeof(expected), sizeof(buf));
+    EXPECT_EQ(memcmp(buf, expected, sizeof(buf)), 0);
+
+    // same as hand written BufWrite chain
+    byte hand[6];
+    BufWrite16(hand, 0x1234);
+    BufWrite32(hand + 2, (uint32_t)-2);
+    EXPECT_EQ(memcmp(buf, hand, sizeof(hand)), 0);
+}
+
+TEST(SPacket, RoundTrip)
+{
+    uint32_t seed = 3;
+    auto rnd = [&seed]() { seed = seed * 1664525UL + 1013904223UL; return seed; };
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        Msg m;
+        m.id = rnd();
+        m.temp = (int32_t)rnd();
+        m.v = (int32_t)rnd() / 1000.0f;
+        m.on = rnd() & 1;
+        m.delta = (int8_t)rnd();
+        m.stamp = ((uint64_t)rnd() << 32) | rnd();
+        m.le = rnd();
+
+        byte buf[MsgPacket::WireSize];
+        MsgPacket::Encode(buf, m);
+
+        Msg d;
+        memset(&d, 0, sizeof(d));
+        MsgPacket::Decode(buf, d);
+
+        ASSERT_EQ(d.id, m.id);
+        ASSERT_EQ(d.temp, m.temp);
+        ASSERT_EQ(d.v, m.v);
+        ASSERT_EQ(d.on, m.on);
+        ASSERT_EQ(d.delta, m.delta);
+        ASSERT_EQ(d.stamp, m.stamp);
+        ASSERT_EQ(d.le, m.le);
+    }
+}
+
+TEST(SPacket, Cursor)
+{
+    byte buf[MsgPacket::WireSize * 2 + 1];
+    ByteWriter w(buf, sizeof(buf));
+    w.WriteU8(7);
+    MsgPacket::Write(w, Sample());
+    MsgPacket::Write(w, Sample());
+    EXPECT_TRUE(w.Ok());
+    MsgPacket::Write(w, Sample());
+    EXPECT_FALSE(w.Ok());
+
+    ByteReader r(buf, sizeof(buf));
+    EXPECT_EQ(r.ReadU8(), 7);
+    Msg m;
+    MsgPacket::Read(r, m);
+    EXPECT_EQ(m.stamp, Sample().stamp);
+    MsgPacket::Read(r, m);
+    EXPECT_EQ(m.le, Sample().le);
+    EXPECT_TRUE(r.Ok());
+
+    // not enough bytes: `m' untouched
+    m.id = 99;
+    MsgPacket::Read(r, m);
+    EXPECT_FALSE(r.Ok());
+    EXPECT_EQ(m.id, 99);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "SQueue.h"
+
+using namespace SearchAThing::Arduino;
+
+TEST(SQueue, PushPop)
+{
+    SQueue<int, 4> q;
+
+    EXPECT_TRUE(q.Empty());
+    for (int i = 0; i < 4; ++i) EXPECT_TRUE(q.Push(i));
+    EXPECT_TRUE(q.Full());
+    EXPECT_FALSE(q.Push(4));
+
+    int v;
+    EXPECT_TRUE(q.Peek(v));
+    EXPECT_EQ(v, 0);
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(q.Pop(v));
+        EXPECT_EQ(v, i);
+    }
+    EXPECT_FALSE(q.Pop(v));
+    EXPECT_EQ(q.Size(), 0);
+}
+
+// element whose fields must stay consistent: a torn copy breaks `check'
+struct Sample
+{
+    uint32_t seq;
+    uint32_t value;
+    uint32_t check;
+};
+
+// Producer and consumer threads stand for isr and loop(); they yield
+// when blocked ( and now and then anyway ) so that both make progress on
+// a single cpu. Pushes enough elements to wrap the free running indexes.
+template<uint16_t N>
+static void Stress(uint32_t count)
+{
+    SQueue<Sample, N> q;
+
+    std::thread producer([&q, count]() {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            Sample s = { i, i * 2654435761u, 0 };
+            s.check = s.seq ^ s.value;
+            while (!q.Push(s)) std::this_thread::yield();
+            if ((i & 1023) == 0) std::this_thread::yield();
+        }
+    });
+
+    uint32_t next = 0;
+    uint32_t errors = 0;
+    while (next < count)
+    {
+        Sample s;
+        if (!q.Pop(s))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        if (s.seq != next || s.check != (s.seq ^ s.value)) ++errors;
+        ++next;
+    }
+
+    producer.join();
+
+    EXPECT_EQ(errors, 0u);
+    EXPECT_TRUE(q.Empty());
+}
+
+TEST(SQueue, StressSmall)
+{
+    Stress<4>(200000);
+}
+
+TEST(SQueue, StressWrap)
+{
+    Stress<128>(300000);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "SScheduler.h"
+
+#include "HostCapture.h"
+
+using namespace SearchAThing::Arduino;
+
+// injected clock
+static unsigned long now;
+static unsigned long Clock() { return now; }
+
+// task log: ( task tag, run time )
+static std::vector<std::pair<int, unsigned long>> runs;
+static void Log(void *ctx) { runs.push_back(std::make_pair((int)(size_t)ctx, now)); }
+
+static const unsigned long WRAP = (unsigned long)-1;
+
+// advances the clock one unit at a time running the scheduler
+static void RunUntil(SScheduler<4>& s, unsigned long end)
+{
+    while (now != end)
+    {
+        ++now;
+        s.Run();
+    }
+}
+
+TEST(SScheduler, PeriodicAcrossRollover)
+{
+    runs.clear();
+    now = WRAP - 120;
+
+    SScheduler<4> s(Clock);
+    s.Every(50, Log, (void *)1, 50);
+    RunUntil(s, 130);
+
+    // due at -70, -20, +30 ... wrapping between the 2nd and 3rd run
+    std::vector<std::pair<int, unsigned long>> expected = {
+        { 1, WRAP - 70 }, { 1, WRAP - 20 }, { 1, 29 }, { 1, 79 }, { 1, 129 } };
+    EXPECT_EQ(runs, expected);
+    EXPECT_EQ(s.Stats(0).runs, 5u);
+    EXPECT_EQ(s.Stats(0).overruns, 0);
+}
+
+TEST(SScheduler, OrderAcrossRollover)
+{
+    runs.clear();
+    now = WRAP - 10;
+
+    SScheduler<4> s(Clock);
+    // due after wrap ( small value ) must not run before the one due
+    // before wrap ( large value )
+    s.After(30, Log, (void *)2);
+    s.After(5, Log, (void *)1);
+    EXPECT_EQ(s.SleepFor(), 5ul);
+
+    RunUntil(s, 40);
+
+    std::vector<std::pair<int, unsigned long>> expected = {
+        { 1, WRAP - 5 }, { 2, 19 } };
+    EXPECT_EQ(runs, expected);
+    EXPECT_EQ(s.Size(), 0);
+    EXPECT_EQ(s.SleepFor(), SSCHEDULER_IDLE);
+}
+
+TEST(SScheduler, SleepForAcrossRollover)
+{
+    now = WRAP - 3;
+
+    SScheduler<4> s(Clock);
+    s.After(10, Log);
+    EXPECT_EQ(s.SleepFor(), 10ul);
+
+    now = 2; // 6 units later
+    EXPECT_EQ(s.SleepFor(), 4ul);
+
+    now = 20; // late
+    EXPECT_EQ(s.SleepFor(), 0ul);
+}
+
+TEST(SScheduler, OverrunAcrossRollover)
+{
+    runs.clear();
+    now = WRAP - 5;
+
+    SScheduler<4> s(Clock);
+    s.Every(10, Log, (void *)1);
+
+    // loop stalled across the wrap for more than a period
+    now = 30;
+    s.Run();
+    EXPECT_EQ(s.Stats(0).overruns, 1);
+
+    // rescheduled a period after the late run
+    EXPECT_EQ(s.SleepFor(), 10ul);
+}
+
+TEST(SScheduler, FullLogsOnSchedChannel)
+{
+    SScheduler<4> s(Clock);
+    for (int i = 0; i < 4; ++i) EXPECT_EQ(s.After(1, Log), i);
+
+    TakeCapture();
+    EXPECT_EQ(s.After(1, Log), -1);
+    EXPECT_EQ(TakeCapture(), "scheduler full\n");
+
+    DLogSetChannels(DLOG_CH_USER);
+    EXPECT_EQ(s.After(1, Log), -1);
+    EXPECT_EQ(TakeCapture(), "");
+    DLogSetChannels(DLOG_CHANNELS);
+}
+
+TEST(SScheduler, StatsOutOfRange)
+{
+    now = 0;
+    SScheduler<4> s(Clock);
+
+    EXPECT_EQ(s.Stats(-1).runs, 0u);
+    EXPECT_EQ(s.Stats(4).runs, 0u);
+    EXPECT_EQ(s.Stats(4).maxTime, 0ul);
+}
@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Util.h"
+
+using namespace SearchAThing::Arduino;
+
+static std::string FloatStr(float f, int prec)
+{
+    char buf[20];
+    FloatToString(buf, f, prec);
+    return buf;
+}
+
+TEST(FloatToString, Basic)
+{
+    EXPECT_EQ(FloatStr(0.0f, 2), "0.00");
+    EXPECT_EQ(FloatStr(1.5f, 1), "1.5");
+    EXPECT_EQ(FloatStr(-0.5f, 2), "-0.50");
+    EXPECT_EQ(FloatStr(-0.0f, 1), "-0.0");
+    EXPECT_EQ(FloatStr(123.456f, 0), "123");
+    EXPECT_EQ(FloatStr(0.125f, 7), "0.1250000");
+    EXPECT_EQ(FloatStr(9.99f, 1), "10.0");
+    EXPECT_EQ(FloatStr(4294967040.0f, 0), "4294967040");
+}
+
+TEST(FloatToString, Clamp)
+{
+    EXPECT_EQ(FloatStr(1.0f, -3), "1");
+    EXPECT_EQ(FloatStr(1.0f, 12), "1.0000000");
+}
+
+TEST(FloatToString, NonFinite)
+{
+    EXPECT_EQ(FloatStr(NAN, 2), "nan");
+    EXPECT_EQ(FloatStr(INFINITY, 2), "inf");
+    EXPECT_EQ(FloatStr(-INFINITY, 2), "-inf");
+}
+
+TEST(FloatToString, Exponent)
+{
+    EXPECT_EQ(FloatStr(1e12f, 2), "1.00e+12");
+    EXPECT_EQ(FloatStr(-2.5e20f, 1), "-2.5e+20");
+}
+
+TEST(Util, BufWriteRead)
+{
+    byte buf[4];
+
+    BufWrite16(buf, 0x1234);
+    EXPECT_EQ(buf[0], 0x12);
+    EXPECT_EQ(buf[1], 0x34);
+    EXPECT_EQ(BufReadUInt16_t(buf), 0x1234);
+
+    BufWrite32(buf, 0xdeadbeef);
+    EXPECT_EQ(buf[0], 0xde);
+    EXPECT_EQ(buf[3], 0xef);
+    EXPECT_EQ(BufReadUInt32_t(buf), 0xdeadbeefu);
+}
+
+TEST(Util, ToDec)
+{
+    char buf[11];
+
+    EXPECT_EQ(std::string(buf, UInt16ToDec(buf, 0)), "0");
+    EXPECT_EQ(std::string(buf, UInt16ToDec(buf, 42, 4)), "0042");
+    EXPECT_EQ(std::string(buf, UInt32ToDec(buf, 4294967295UL)), "4294967295");
+    EXPECT_EQ(std::string(buf, UInt32ToDec(buf, 7, 3)), "007");
+}
+
+TEST(Util, ByteToHex)
+{
+    char buf[2];
+    ByteToHex(buf, 0xa5);
+    EXPECT_EQ(std::string(buf, 2), "a5");
+}
+
+TEST(Util, TimeDiff)
+{
+    EXPECT_EQ(TimeDiff(10, 25), 15ul);
+    // across rollover
+    EXPECT_EQ(TimeDiff((unsigned long)-5, 10), 15ul);
+}
+
+TEST(FloatToString, Exact)
+{
+    // digits come from the binary value rather than float rounding
+    EXPECT_EQ(FloatStr(-0.92384999990463f, 4), "-0.9238");
+    EXPECT_EQ(FloatStr(61.9945449829f, 5), "61.99454");
+    EXPECT_EQ(FloatStr(1e-30f, 7), "0.0000000");
+    EXPECT_EQ(FloatStr(0.00000005f, 7), "0.0000001");
+}
+
+// Compares against printf on random values below 2^32 ; exact ties are
+// skipped since printf rounds them half to even.
+TEST(FloatToString, MatchesPrintf)
+{
+    uint32_t seed = 12345;
+    auto rnd = [&seed]() { seed = seed * 1664525UL + 1013904223UL; return seed; };
+
+    for (int i = 0; i < 200000; ++i)
+    {
+        uint32_t bits = rnd();
+        float f;
+        memcpy(&f, &bits, sizeof(f));
+        if (!isfinite(f) || fabsf(f) >= 4294967296.0f) continue;
+        int prec = rnd() % 8;
+
+        // float * 10^prec is exact in double ( 24 + 24 bits )
+        double scaled = fabs((double)f) * pow(10.0, prec);
+        if (scaled - floor(scaled) == 0.5) continue;
+
+        char expected[64];
+        snprintf(expected, sizeof(expected), "%.*f", prec, (double)f);
+        ASSERT_EQ(FloatStr(f, prec), expected) << "bits=0x" << std::hex << bits << " prec=" << std::dec << prec;
+    }
+}
+
+extern char *__brkval;
+extern struct __freelist *__flp;
+extern char *__malloc_heap_start;
+extern char *__malloc_heap_end;
+
+// Heap of the avr-libc malloc model in the shim ( size_t chunk header ).
+class FreeMemoryTest : public ::testing::Test
+{
+protected:
+    alignas(16) char heap[600];
+
+    // checks FreeMemoryMaxBlock against bisection and against malloc
+    void Check(int expected)
+    {
+        int max = FreeMemoryMaxBlock();
+        EXPECT_EQ(max, expected);
+        EXPECT_EQ(FreeMemoryMaxBlockBisect(), max);
+
+        void *p = _ShimMalloc(max);
+        EXPECT_NE(p, nullptr);
+        _ShimFree(p);
+        EXPECT_EQ(_ShimMalloc(max + 1), nullptr);
+    }
+
+    void SetUp() override
+    {
+        __flp = NULL;
+        __brkval = NULL;
+        __malloc_heap_start = heap;
+        __malloc_heap_end = heap + sizeof(heap);
+    }
+
+    void TearDown() override
+    {
+        __flp = NULL;
+        __brkval = NULL;
+        __malloc_heap_start = NULL;
+        __malloc_heap_end = NULL;
+    }
+};
+
+TEST_F(FreeMemoryTest, MaxBlockMatchesBisect)
+{
+    const int hdr = sizeof(size_t);
+
+    Check(sizeof(heap) - hdr);
+
+    void *a = _ShimMalloc(100);
+    void *b = _ShimMalloc(200);
+    void *c = _ShimMalloc(50);
+    void *d = _ShimMalloc(100);
+    ASSERT_TRUE(a && b && c && d);
+    Check(sizeof(heap) - 4 * hdr - 450 - hdr);
+
+    // hole in the middle larger than the heap top room
+    _ShimFree(b);
+    Check(200);
+
+    // topmost chunk given back to the heap top
+    _ShimFree(d);
+    Check(sizeof(heap) - 3 * hdr - 350 - hdr);
+
+    // heap top exhausted: free list chunk only
+    void *e = _ShimMalloc(sizeof(heap) - 3 * hdr - 350 - hdr);
+    ASSERT_NE(e, nullptr);
+    Check(200);
+
+    // adjacent chunks merged
+    _ShimFree(a);
+    Check(100 + hdr + 200);
+
+    _ShimFree(c);
+    _ShimFree(e);
+    Check(sizeof(heap) - hdr);
+}
@@ -0,0 +1,142 @@
+// Firmware run by avr-cycles-report.sh in an avr simulator: times each
+// library hot function with the DPROFILE timer1 probes ( cpu cycles ) and
+// prints one "cycles <min> <avg> <name>" line per function on Serial,
+// then sleeps with interrupts off so that the simulator stops.
+//
+// Build flags: -DDPROFILE -DDPROFILE_TIMER1 -DDPRINT_SINK=DPRINT_SINK_STREAM
+
+#include <Arduino.h>
+#include <avr/sleep.h>
+
+#include "DebugMacros.h"
+#include "DPrint.h"
+#include "DProfile.h"
+#include "DLine.h"
+#include "Util.h"
+#include "SList.h"
+#include "SQueue.h"
+#include "SScheduler.h"
+#include "ByteStream.h"
+#include "SPacket.h"
+
+#if !defined(DPROFILE) || !defined(DPROFILE_TIMER1) || DPRINT_SINK != DPRINT_SINK_STREAM
+#error "build with -DDPROFILE -DDPROFILE_TIMER1 -DDPRINT_SINK=DPRINT_SINK_STREAM"
+#endif
+
+using namespace SearchAThing::Arduino;
+
+// calls timed for each function
+#define RUNS 32
+
+// discards DPrint output while timing so that only the formatting cost
+// is measured ( no wait for the uart )
+class NullPrint : public Print
+{
+public:
+	size_t write(uint8_t) { return 1; }
+};
+
+static NullPrint nullPrint;
+
+// cycles of an empty probe pair
+static DProfileTick overhead;
+
+// inputs read through volatiles so that calls aren't constant folded
+static volatile uint32_t v32 = 3141592653UL;
+static volatile float vf = 1234.5678f;
+
+// results of side effect free calls are stored here to keep them
+static volatile int sink;
+
+struct Msg
+{
+	uint16_t id;
+	int32_t temp;
+	float v;
+};
+typedef SPacket<SFIELD(Msg, id), SFIELD(Msg, temp), SFIELD(Msg, v)> MsgPacket;
+
+static SList<int> list;
+static SQueue<byte, 16> queue;
+static SScheduler<4> sched;
+static byte buf[32];
+static char str[24];
+static Msg msg = { 1, -200, 3.5f };
+
+static void Nop(void *) {}
+
+// Prints probe 0 statistics net of the probe overhead.
+static void Report(const __FlashStringHelper *name)
+{
+	const DProfileSlot& s = _DProfileSlots[0];
+
+	DPrintSetStream(&Serial);
+	DLogln(F("cycles "), s.min - overhead, ' ', s.total / s.count - overhead, ' ', name);
+	Serial.flush();
+}
+
+// Times RUNS executions of `stmt' with interrupts disabled ( timer0
+// millis isr would add to some runs ) and reports them as `name'.
+#define MEASURE(name, stmt) \
+	do \
+	{ \
+		DProfileReset(); \
+		DPrintSetStream(&nullPrint); \
+		cli(); \
+		for (uint8_t run = 0; run < RUNS; ++run) \
+		{ \
+			DPROFILE_BEGIN(0); \
+			stmt; \
+			DPROFILE_END(0); \
+		} \
+		sei(); \
+		Report(F(name)); \
+	} while (0)
+
+void setup()
+{
+	Serial.begin(115200);
+
+	DProfileReset();
+	cli();
+	overhead = DProfileCalibrate();
+	sei();
+
+	MEASURE("UInt32ToDec", UInt32ToDec(str, v32));
+	MEASURE("FloatToString prec 2", FloatToString(str, vf, 2));
+	MEASURE("FloatToString prec 7", FloatToString(str, vf, 7));
+	MEASURE("DPrintUInt32", DPrintUInt32(v32));
+	MEASURE("DPrintFloat", DPrintFloat(vf, 2));
+	MEASURE("DPrintHexBytes 16 bytes", DPrintHexBytes(buf, 16));
+	MEASURE("DLogln", DLogln(F("t="), v32, F(" v="), vf));
+	MEASURE("DLine", DLine<32> l; l.Flash(F("t=")).UInt32(v32).Flash(F(" v=")).Float(vf, 2); l.Commitln());
+	MEASURE("BufWrite32", BufWrite32(buf, v32));
+
+	for (int i = 0; i < 16; ++i) list.Add(i);
+	MEASURE("SList::Get sequential", sink = list.Get(run & 15));
+	MEASURE("SList::Get far", sink = list.Get(run & 1 ? 15 : 0));
+	MEASURE("SList::Add Remove", list.Add(run); list.Remove(16));
+
+	byte b;
+	MEASURE("SQueue::Push Pop", queue.Push(run); queue.Pop(b));
+
+	MEASURE("ByteWriter::WriteVarint", ByteWriter w(buf, sizeof(buf)); w.WriteVarint(v32));
+
+	MEASURE("SPacket::Encode", MsgPacket::Encode(buf, msg));
+	MEASURE("SPacket::Decode", MsgPacket::Decode(buf, msg));
+
+	for (int i = 0; i < 4; ++i) sched.Every(1000, Nop, NULL, 1000);
+	MEASURE("SScheduler::Run idle", sink = sched.Run());
+
+	DPrintSetStream(&Serial);
+	DLogln(F("cycles done"));
+	Serial.flush();
+
+	cli();
+	sleep_enable();
+	sleep_cpu();
+}
+
+void loop()
+{
+}
@@ -0,0 +1,150 @@
+#!/bin/bash
+#
+# Builds avr-cycles-probe.cpp with the library and the arduino core using
+# avr-gcc ( -Os as the Arduino IDE does ), runs it in simavr and reports
+# cpu cycles per call ( min and average net of probe overhead ) of each
+# hot function, then checks averages against a budgets file failing if
+# one is exceeded. Flash and ram footprint of the same functions are
+# reported by avr-size-report.sh.
+#
+# usage:
+#   ARDUINO_AVR=~/.arduino15/packages/arduino/hardware/avr/1.8.6 \
+#     tools/avr-cycles-report.sh [-u] [budgets-file]
+#
+#   -u            rewrite budgets file limits with the current cycles
+#   budgets-file  defaults to tools/avr-cycle-budgets.txt
+#
+# environment:
+#   ARDUINO_AVR   arduino avr core folder ( cores/ and variants/ )
+#   MCU           default atmega328p
+#   VARIANT       default standard
+#   CC, CXX       toolchain ( default avr-gcc, avr-g++ )
+#   SIMAVR        simulator ( default simavr )
+#   EXTRA_FLAGS   appended to compile flags
+#
+
+set -e
+
+root="$(cd "$(dirname "$0")/.." && pwd)"
+lib="$root/arduino-utils"
+
+update=0
+if [ "$1" == "-u" ]; then
+	update=1
+	shift
+fi
+budgets="${1:-$root/tools/avr-cycle-budgets.txt}"
+
+CC="${CC:-avr-gcc}"
+CXX="${CXX:-avr-g++}"
+SIMAVR="${SIMAVR:-simavr}"
+MCU="${MCU:-atmega328p}"
+
+if [ -z "$ARDUINO_AVR" ] || [ ! -d "$ARDUINO_AVR/cores/arduino" ]; then
+	echo "set ARDUINO_AVR to the arduino avr core folder" >&2
+	exit 2
+fi
+core="$ARDUINO_AVR/cores/arduino"
+
+FLAGS="-c -Os -ffunction-sections -fdata-sections \
+	-mmcu=$MCU -DF_CPU=16000000L -DARDUINO=10800 -DARDUINO_ARCH_AVR \
+	-I$core -I$ARDUINO_AVR/variants/${VARIANT:-standard} -I$lib \
+	-DDPROFILE -DDPROFILE_TIMER1 -DDPRINT_SINK=DPRINT_SINK_STREAM $EXTRA_FLAGS"
+CXXFLAGS="$FLAGS -std=gnu++11 -fno-exceptions -fno-threadsafe-statics"
+
+out="$(mktemp -d)"
+trap 'rm -rf "$out"' EXIT
+
+# arduino core built as the IDE does ( warnings off, -fpermissive c++ ),
+# library and probe with warnings on
+for src in "$core"/*.c; do
+	[ -e "$src" ] && $CC $FLAGS -w "$src" -o "$out/core_$(basename "$src").o"
+done
+for src in "$core"/*.S; do
+	[ -e "$src" ] && $CC $FLAGS -w -x assembler-with-cpp "$src" -o "$out/core_$(basename "$src").o"
+done
+for src in "$core"/*.cpp; do
+	$CXX $CXXFLAGS -w -fpermissive "$src" -o "$out/core_$(basename "$src").o"
+done
+for src in "$lib"/*.cpp "$root/tools/avr-cycles-probe.cpp"; do
+	$CXX $CXXFLAGS -Wall "$src" -o "$out/$(basename "$src").o"
+done
+
+$CC -Os -mmcu=$MCU -Wl,--gc-sections "$out"/*.o -o "$out/probe.elf" -lm
+
+#---------------------------------------------------------------------------
+# cycles: "<min> <avg> <name>" per line printed by the probe on the uart
+# ( simavr echoes uart lines on its output, colors are stripped )
+#---------------------------------------------------------------------------
+
+timeout 120 $SIMAVR -m $MCU -f 16000000 "$out/probe.elf" 2>&1 | \
+	sed 's/\x1b\[[0-9;]*m//g' | grep -o 'cycles .*' | cut -d' ' -f2- > "$out/sim.txt" || true
+
+if ! grep -q '^done' "$out/sim.txt"; then
+	echo "probe didn't complete in $SIMAVR" >&2
+	cat "$out/sim.txt" >&2
+	exit 1
+fi
+grep -v '^done' "$out/sim.txt" > "$out/cycles.txt"
+
+echo "=== cycles per call ( min avg ) ==="
+cat "$out/cycles.txt"
+
+#---------------------------------------------------------------------------
+# budgets: "<max avg cycles> <name>" per line ; a "-" limit
+# ( not measured yet ) and a name missing from the report fail the check
+# too ( -u sets unset limits )
+#---------------------------------------------------------------------------
+
+[ -f "$budgets" ] || exit 0
+
+echo
+echo "=== budgets ( $budgets ) ==="
+
+awk -v update="$update" -v newfile="$out/budgets.new" '
+	FNR == NR {
+		avg = $2
+		name = $3
+		for (i = 4; i <= NF; ++i) name = name " " $i
+		cycles[name] = avg
+		next
+	}
+	/^[ \t]*(#|$)/ {
+		print > newfile
+		next
+	}
+	{
+		name = $2
+		for (i = 3; i <= NF; ++i) name = name " " $i
+
+		if (!(name in cycles)) {
+			printf "%-8s %6s / %6s %s\n", "MISSING", "-", $1, name
+			++missing
+			print > newfile
+			next
+		}
+
+		avg = cycles[name] + 0
+		if ($1 == "-") {
+			printf "%-8s %6d / %6s %s\n", "UNSET", avg, "-", name
+			++unset
+		} else {
+			max = $1 + 0
+			status = avg > max ? "OVER" : "ok"
+			if (avg > max) ++over
+			printf "%-8s %6d / %6d %s\n", status, avg, max, name
+		}
+		printf "%d %s\n", avg, name > newfile
+	}
+	END {
+		if (update) exit 0
+		exit over + unset + missing > 0 ? 1 : 0
+	}' "$out/cycles.txt" "$budgets" || {
+	echo "budget exceeded, missing or not set ( -u sets unset ones )" >&2
+	exit 1
+}
+
+if [ $update -eq 1 ]; then
+	cp "$out/budgets.new" "$budgets"
+	echo "budgets updated"
+fi
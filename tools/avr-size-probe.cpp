@@ -0,0 +1,17 @@
+// Explicit instantiations of the library templates so that
+// avr-size-report.sh can measure their code size ( templates emit no code
+// until used ).
+
+#include "SList.h"
+#include "SVector.h"
+#include "SRing.h"
+#include "SQueue.h"
+#include "SScheduler.h"
+
+using namespace SearchAThing::Arduino;
+
+template class SearchAThing::Arduino::SList<int>;
+template class SearchAThing::Arduino::SVector<int, 8>;
+template class SearchAThing::Arduino::SRing<int, 8>;
+template class SearchAThing::Arduino::SQueue<byte, 16>;
+template class SearchAThing::Arduino::SScheduler<4>;
@@ -0,0 +1,151 @@
+#!/bin/bash
+#
+# Builds the library with avr-gcc ( -Os as the Arduino IDE does ) and
+# reports flash and ram size of each function / variable and of each
+# object, then checks sizes against a budgets file failing if one is
+# exceeded.
+#
+# usage:
+#   ARDUINO_AVR=~/.arduino15/packages/arduino/hardware/avr/1.8.6 \
+#     tools/avr-size-report.sh [-u] [budgets-file]
+#
+#   -u            rewrite budgets file limits with the current sizes
+#   budgets-file  defaults to tools/avr-budgets.txt
+#
+# environment:
+#   ARDUINO_AVR   arduino avr core folder ( cores/ and variants/ )
+#   MCU           default atmega328p
+#   VARIANT       default standard
+#   CXX, NM, SIZE toolchain ( default avr-g++, avr-nm, avr-size )
+#   CORE_FLAGS    overrides mcu and core include flags
+#   EXTRA_FLAGS   appended to compile flags ( eg. -DDPRINT_TX_BUFFER=64 )
+#
+
+set -e
+
+root="$(cd "$(dirname "$0")/.." && pwd)"
+lib="$root/arduino-utils"
+
+update=0
+if [ "$1" == "-u" ]; then
+	update=1
+	shift
+fi
+budgets="${1:-$root/tools/avr-budgets.txt}"
+
+CXX="${CXX:-avr-g++}"
+NM="${NM:-avr-nm}"
+SIZE="${SIZE:-avr-size}"
+MCU="${MCU:-atmega328p}"
+
+if [ -z "$CORE_FLAGS" ]; then
+	if [ -z "$ARDUINO_AVR" ] || [ ! -d "$ARDUINO_AVR/cores/arduino" ]; then
+		echo "set ARDUINO_AVR to the arduino avr core folder" >&2
+		exit 2
+	fi
+	CORE_FLAGS="-mmcu=$MCU -DF_CPU=16000000L -DARDUINO=10800 -DARDUINO_ARCH_AVR \
+		-I$ARDUINO_AVR/cores/arduino -I$ARDUINO_AVR/variants/${VARIANT:-standard}"
+fi
+
+CXXFLAGS="-c -Os -std=gnu++11 -Wall -fno-exceptions -fno-threadsafe-statics \
+	-ffunction-sections -fdata-sections $CORE_FLAGS -I$lib $EXTRA_FLAGS"
+
+out="$(mktemp -d)"
+trap 'rm -rf "$out"' EXIT
+
+for src in "$lib"/*.cpp "$root/tools/avr-size-probe.cpp"; do
+	$CXX $CXXFLAGS "$src" -o "$out/$(basename "$src" .cpp).o"
+done
+
+#---------------------------------------------------------------------------
+# symbols: "<size> <flash|ram> <demangled name>" ( inline and template
+# functions emitted by more objects are counted once )
+#---------------------------------------------------------------------------
+
+$NM -S -C --radix=d "$out"/*.o | awk '
+	NF >= 4 && $3 ~ /^[tTwWdDbBrRvV]$/ {
+		size = $2 + 0
+		kind = ($3 ~ /^[tTwWrR]$/) ? "flash" : "ram"
+		name = $4
+		for (i = 5; i <= NF; ++i) name = name " " $i
+		key = kind " " name
+		if (!(key in sizes) || sizes[key] < size) sizes[key] = size
+	}
+	END {
+		for (key in sizes) printf "%6d %s\n", sizes[key], key
+	}' | sort -k1,1nr > "$out/symbols.txt"
+
+echo "=== functions and variables ( bytes ) ==="
+cat "$out/symbols.txt"
+
+echo
+echo "=== objects ==="
+$SIZE -t "$out"/*.o | sed "s|$out/||"
+
+#---------------------------------------------------------------------------
+# budgets: "<max bytes> <name prefix>" per line, sizes of all symbols
+# starting with the prefix ( eg. overloads ) are summed ; a "-" limit
+# ( not measured yet ) and a name missing from the report fail the check
+# too ( -u sets unset limits )
+#---------------------------------------------------------------------------
+
+[ -f "$budgets" ] || exit 0
+
+echo
+echo "=== budgets ( $budgets ) ==="
+
+awk -v update="$update" -v newfile="$out/budgets.new" '
+	FNR == NR {
+		size = $1
+		name = $3
+		for (i = 4; i <= NF; ++i) name = name " " $i
+		syms[++n] = name
+		symsize[n] = size
+		next
+	}
+	/^[ \t]*(#|$)/ {
+		print > newfile
+		next
+	}
+	{
+		prefix = $2
+		for (i = 3; i <= NF; ++i) prefix = prefix " " $i
+
+		tot = 0
+		found = 0
+		for (i = 1; i <= n; ++i)
+			if (index(syms[i], prefix) == 1) {
+				tot += symsize[i]
+				found = 1
+			}
+
+		if (!found) {
+			printf "%-8s %6s / %6s %s\n", "MISSING", "-", $1, prefix
+			++missing
+			print > newfile
+			next
+		}
+
+		if ($1 == "-") {
+			printf "%-8s %6d / %6s %s\n", "UNSET", tot, "-", prefix
+			++unset
+		} else {
+			max = $1 + 0
+			status = tot > max ? "OVER" : "ok"
+			if (tot > max) ++over
+			printf "%-8s %6d / %6d %s\n", status, tot, max, prefix
+		}
+		printf "%d %s\n", tot, prefix > newfile
+	}
+	END {
+		if (update) exit 0
+		exit over + unset + missing > 0 ? 1 : 0
+	}' "$out/symbols.txt" "$budgets" || {
+	echo "budget exceeded, missing or not set ( -u sets unset ones )" >&2
+	exit 1
+}
+
+if [ $update -eq 1 ]; then
+	cp "$out/budgets.new" "$budgets"
+	echo "budgets updated"
+fi
@@ -0,0 +1,67 @@
+// Representative logging code built by size-compare.sh twice: with
+// DLog / DLogln calls and ( baseline ) with the equivalent chains of
+// DPrint calls.
+
+#include "DebugMacros.h"
+#include "DPrint.h"
+
+using namespace SearchAThing::Arduino;
+
+#ifdef SIZE_COMPARE_BASELINE
+
+#define LOG_MEM(blk, frg)                   \
+	{                                       \
+		DPrintF(F("free blk="));            \
+		DPrintInt16(blk);                   \
+		DPrintF(F(" frg="));                \
+		DPrintInt16ln(frg);                 \
+	}
+
+#define LOG_SENSOR(id, t, v)                \
+	{                                       \
+		DPrintF(F("sensor "));              \
+		DPrintUInt16(id);                   \
+		DPrintF(F(" t="));                  \
+		DPrintUInt32(t);                    \
+		DPrintF(F(" v="));                  \
+		DPrintFloatln(v);                   \
+	}
+
+#else
+
+#define LOG_MEM(blk, frg) DLogln(F("free blk="), blk, F(" frg="), frg)
+#define LOG_SENSOR(id, t, v) DLogln(F("sensor "), id, F(" t="), t, F(" v="), v)
+
+#endif
+
+volatile int16_t blk, frg;
+volatile uint16_t id;
+volatile uint32_t t;
+volatile float v;
+
+// call sites spread over distinct functions as in a sketch
+void Site1() { LOG_MEM(blk, frg); }
+void Site2() { LOG_MEM(frg, blk); }
+void Site3() { LOG_SENSOR(id, t, v); }
+void Site4() { LOG_SENSOR(id + 1, t, v * 2); }
+void Site5() { LOG_MEM(blk + 1, frg - 1); }
+void Site6() { LOG_SENSOR(id, t + 1, v); }
+void Site7() { LOG_MEM(blk, 0); }
+void Site8() { LOG_SENSOR(0, t, v); }
+
+void setup()
+{
+	Site1(); Site2(); Site3(); Site4();
+	Site5(); Site6(); Site7(); Site8();
+}
+
+void loop() {}
+
+#ifndef ARDUINO_ARCH_AVR
+// host build has no arduino core main
+int main()
+{
+	setup();
+	return 0;
+}
+#endif
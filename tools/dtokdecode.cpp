@@ -0,0 +1,130 @@
+// dtokdecode - rebuilds text from DPrintTok binary records
+//
+// build : g++ -O2 -o dtokdecode tools/dtokdecode.cpp
+// usage : dtokdecode sketch.elf < capture.bin
+//
+// Reads the serial capture from stdin and writes decoded text to stdout.
+// Flash strings are looked up by address into the allocated sections of
+// the given avr elf ( the one built for the sketch that produced the
+// capture ). Bytes outside records are copied as is.
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <string>
+
+#include "dtokdecode.h"
+
+// avr-gcc maps sram sections at this offset
+#define AVR_DATA_VMA 0x800000
+
+struct FlashSection
+{
+    uint32_t addr;
+    std::vector<uint8_t> data;
+};
+
+static uint32_t rd16le(const uint8_t *p) { return p[0] | (p[1] << 8); }
+
+static uint32_t rd32le(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Loads allocated progbits sections of flash address space from the
+// given elf32 little endian file.
+static bool LoadElf(const char *path, std::vector<FlashSection> &sections)
+{
+    FILE *f = fopen(path, "rb");
+    if (f == NULL)
+        return false;
+
+    std::vector<uint8_t> elf;
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0)
+        elf.insert(elf.end(), chunk, chunk + n);
+    fclose(f);
+
+    if (elf.size() < 0x34 || memcmp(elf.data(), "\x7f" "ELF", 4) != 0 ||
+        elf[4] != 1 /* ELFCLASS32 */ || elf[5] != 1 /* ELFDATA2LSB */)
+        return false;
+
+    uint32_t shoff = rd32le(&elf[0x20]);
+    uint32_t shentsize = rd16le(&elf[0x2e]);
+    uint32_t shnum = rd16le(&elf[0x30]);
+
+    for (uint32_t i = 0; i < shnum; ++i)
+    {
+        uint32_t off = shoff + i * shentsize;
+        if (off + 0x28 > elf.size())
+            return false;
+
+        const uint8_t *sh = &elf[off];
+        uint32_t type = rd32le(sh + 0x04);
+        uint32_t flags = rd32le(sh + 0x08);
+        uint32_t addr = rd32le(sh + 0x0c);
+        uint32_t offset = rd32le(sh + 0x10);
+        uint32_t size = rd32le(sh + 0x14);
+
+        // SHT_PROGBITS with SHF_ALLOC in flash space
+        if (type != 1 || !(flags & 2) || addr >= AVR_DATA_VMA)
+            continue;
+        if (offset + size > elf.size())
+            return false;
+
+        FlashSection s;
+        s.addr = addr;
+        s.data.assign(elf.begin() + offset, elf.begin() + offset + size);
+        sections.push_back(s);
+    }
+
+    return !sections.empty();
+}
+
+static std::string FlashString(const std::vector<FlashSection> &sections,
+                               uint32_t addr)
+{
+    for (auto &s : sections)
+    {
+        if (addr < s.addr || addr >= s.addr + s.data.size())
+            continue;
+
+        std::string res;
+        for (auto i = addr - s.addr; i < s.data.size() && s.data[i]; ++i)
+            res += (char)s.data[i];
+        return res;
+    }
+
+    char buf[32];
+    snprintf(buf, sizeof(buf), "<?0x%04x>", addr);
+    return buf;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s sketch.elf < capture.bin\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<FlashSection> sections;
+    if (!LoadElf(argv[1], sections))
+    {
+        fprintf(stderr, "unable to load flash sections from %s\n", argv[1]);
+        return 1;
+    }
+
+    std::vector<uint8_t> in;
+    int c;
+    while ((c = fgetc(stdin)) != EOF)
+        in.push_back((uint8_t)c);
+
+    auto lookup = [&sections](uint32_t addr) { return FlashString(sections, addr); };
+    auto text = DTokDecode(lookup, in.data(), in.size());
+    fwrite(text.data(), 1, text.size(), stdout);
+
+    return 0;
+}
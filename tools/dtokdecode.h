@@ -0,0 +1,235 @@
+// dtokdecode - DPrintTok record decoder
+//
+// Decoding logic shared by the dtokdecode tool and the host tests; flash
+// strings are resolved through a lookup function so that records can be
+// decoded without an elf.
+
+#ifndef _SEARCHATHING_ARDUINO_UTILS_DTOKDECODE_H
+#define _SEARCHATHING_ARDUINO_UTILS_DTOKDECODE_H
+
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+
+// keep in sync with arduino-utils/DPrintTok.h
+#define DTOK_SYNC 0x1e
+
+#define DTOK_NONE 0
+#define DTOK_U8 1
+#define DTOK_U16 2
+#define DTOK_U32 3
+#define DTOK_I16 4
+#define DTOK_I32 5
+#define DTOK_FLOAT 6
+
+#define DTOK_TYPE_MASK 0x0f
+#define DTOK_PREC_SHIFT 4
+#define DTOK_PREC_MASK 0x70
+#define DTOK_NEWLINE 0x80
+
+// Returns text of the flash string at the given address.
+typedef std::function<std::string(uint32_t addr)> DTokStringLookup;
+
+static inline uint32_t DTokRd32be(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+static inline int DTokArgSize(int type)
+{
+    switch (type)
+    {
+    case DTOK_NONE:
+        return 0;
+    case DTOK_U8:
+        return 1;
+    case DTOK_U16:
+    case DTOK_I16:
+        return 2;
+    case DTOK_U32:
+    case DTOK_I32:
+    case DTOK_FLOAT:
+        return 4;
+    }
+    return -1;
+}
+
+// Formats `f' as the device FloatToString ( arduino-utils/Util.cpp, keep
+// in sync ) does: same nan / inf spelling, exponent form "1.00e+12" from
+// 2^32 and exact ties rounded half up, thus decoded text matches DPrint
+// output char by char.
+static inline void DTokFloatToString(char *buf, float f, int prec)
+{
+    char *p = buf;
+
+    if (std::isnan(f))
+    {
+        strcpy(p, "nan");
+        return;
+    }
+
+    if (std::signbit(f))
+    {
+        *p++ = '-';
+        f = -f;
+    }
+
+    if (std::isinf(f))
+    {
+        strcpy(p, "inf");
+        return;
+    }
+
+    if (prec < 0)
+        prec = 0;
+    else if (prec > 7)
+        prec = 7;
+
+    int exp = 0;
+    if (f >= 4294967296.0f)
+    {
+        while (f >= 10.0f)
+        {
+            f /= 10.0f;
+            ++exp;
+        }
+    }
+
+    uint32_t bits;
+    memcpy(&bits, &f, sizeof(bits));
+    int e = (bits >> 23) & 0xff;
+    uint32_t m = bits & 0x7fffffUL;
+    if (e == 0)
+        e = 1;
+    else
+        m |= 0x800000UL;
+    int sh = 150 - e;
+
+    uint32_t scale = 1;
+    for (int i = 0; i < prec; ++i)
+        scale *= 10;
+
+    uint32_t x = 0;
+    uint32_t frac = 0;
+    if (sh <= 0)
+        x = m << -sh;
+    else if (sh <= 48)
+    {
+        uint32_t r = m;
+        if (sh < 24)
+        {
+            x = m >> sh;
+            r = m & ((1UL << sh) - 1);
+        }
+        uint64_t q = (uint64_t)r * scale;
+        frac = (uint32_t)(q >> sh);
+        if ((q >> (sh - 1)) & 1)
+            ++frac;
+    }
+
+    if (frac >= scale)
+    {
+        frac -= scale;
+        ++x;
+
+        if (exp > 0 && x == 10)
+        {
+            x = 1;
+            ++exp;
+        }
+    }
+
+    p += sprintf(p, "%lu", (unsigned long)x);
+    if (prec > 0)
+        p += sprintf(p, ".%0*lu", prec, (unsigned long)frac);
+    if (exp > 0)
+        sprintf(p, "e+%02d", exp);
+}
+
+// Decodes the record starting at `p' ( sync byte included ) appending its
+// text to `out'. Returns record size or 0 if `p' doesn't start a valid
+// record.
+static inline size_t DTokDecodeRecord(const DTokStringLookup &lookup,
+                                      const uint8_t *p, size_t avail,
+                                      std::string &out)
+{
+    if (avail < 4)
+        return 0;
+
+    uint8_t tag = p[3];
+    int type = tag & DTOK_TYPE_MASK;
+    int argSize = DTokArgSize(type);
+    if (argSize < 0 || avail < (size_t)(4 + argSize))
+        return 0;
+
+    out += lookup((p[1] << 8) | p[2]);
+
+    char buf[32];
+    buf[0] = 0;
+
+    const uint8_t *arg = p + 4;
+    switch (type)
+    {
+    case DTOK_U8:
+        snprintf(buf, sizeof(buf), "%u", arg[0]);
+        break;
+    case DTOK_U16:
+        snprintf(buf, sizeof(buf), "%u", (arg[0] << 8) | arg[1]);
+        break;
+    case DTOK_I16:
+        snprintf(buf, sizeof(buf), "%d", (int16_t)((arg[0] << 8) | arg[1]));
+        break;
+    case DTOK_U32:
+        snprintf(buf, sizeof(buf), "%lu", (unsigned long)DTokRd32be(arg));
+        break;
+    case DTOK_I32:
+        snprintf(buf, sizeof(buf), "%ld", (long)(int32_t)DTokRd32be(arg));
+        break;
+    case DTOK_FLOAT:
+    {
+        uint32_t bits = DTokRd32be(arg);
+        float f;
+        memcpy(&f, &bits, 4);
+        DTokFloatToString(buf, f, (tag & DTOK_PREC_MASK) >> DTOK_PREC_SHIFT);
+    }
+    break;
+    }
+
+    out += buf;
+
+    if (tag & DTOK_NEWLINE)
+        out += '\n';
+
+    return 4 + argSize;
+}
+
+// Decodes a capture of DPrintTok records mixed with plain text ( copied
+// as is ) returning the text.
+static inline std::string DTokDecode(const DTokStringLookup &lookup,
+                                     const uint8_t *data, size_t size)
+{
+    std::string out;
+
+    size_t i = 0;
+    while (i < size)
+    {
+        if (data[i] == DTOK_SYNC)
+        {
+            auto n = DTokDecodeRecord(lookup, data + i, size - i, out);
+            if (n > 0)
+            {
+                i += n;
+                continue;
+            }
+        }
+        out += (char)data[i];
+        ++i;
+    }
+
+    return out;
+}
+
+#endif
@@ -0,0 +1,68 @@
+#!/bin/bash
+#
+# Compares flash size of a sketch built twice: as is and with
+# -DSIZE_COMPARE_BASELINE ( the hand written code the library feature
+# replaces ). Both are linked with the library built with avr-gcc
+# ( -Os as the Arduino IDE does ).
+#
+# usage:
+#   ARDUINO_AVR=~/.arduino15/packages/arduino/hardware/avr/1.8.6 \
+#     tools/size-compare.sh tools/dlog-size-sketch.cpp
+#
+# Prints text size of the whole program and of the call sites only
+# ( Site* functions ) so that per call site saving and fixed cost of the
+# library helpers can be told apart.
+#
+# environment: same as avr-size-report.sh ( ARDUINO_AVR, MCU, VARIANT,
+# CXX, NM, SIZE, CORE_FLAGS, EXTRA_FLAGS ) ; eg. a host estimate:
+#   CXX=g++ NM=nm SIZE=size CORE_FLAGS="-I$PWD/host" tools/size-compare.sh <sketch>
+#
+
+set -e
+
+if [ $# -ne 1 ]; then
+	echo "usage: $0 sketch.cpp" >&2
+	exit 2
+fi
+sketch="$(cd "$(dirname "$1")" && pwd)/$(basename "$1")"
+
+root="$(cd "$(dirname "$0")/.." && pwd)"
+lib="$root/arduino-utils"
+
+CXX="${CXX:-avr-g++}"
+NM="${NM:-avr-nm}"
+SIZE="${SIZE:-avr-size}"
+MCU="${MCU:-atmega328p}"
+
+if [ -z "$CORE_FLAGS" ]; then
+	if [ -z "$ARDUINO_AVR" ] || [ ! -d "$ARDUINO_AVR/cores/arduino" ]; then
+		echo "set ARDUINO_AVR to the arduino avr core folder" >&2
+		exit 2
+	fi
+	CORE_FLAGS="-mmcu=$MCU -DF_CPU=16000000L -DARDUINO=10800 -DARDUINO_ARCH_AVR \
+		-I$ARDUINO_AVR/cores/arduino -I$ARDUINO_AVR/variants/${VARIANT:-standard}"
+	LINK_SRCS="$ARDUINO_AVR/cores/arduino/*.c $ARDUINO_AVR/cores/arduino/*.cpp"
+else
+	# host shim
+	LINK_SRCS="$root/host/ArduinoShim.cpp"
+fi
+
+CXXFLAGS="-Os -std=gnu++11 -w -fno-exceptions -fno-threadsafe-statics \
+	-ffunction-sections -fdata-sections -Wl,--gc-sections \
+	$CORE_FLAGS -I$lib $EXTRA_FLAGS"
+
+out="$(mktemp -d)"
+trap 'rm -rf "$out"' EXIT
+
+build()
+{
+	$CXX $CXXFLAGS $1 "$sketch" "$lib"/*.cpp $LINK_SRCS \
+		-o "$out/$2"
+	text=$($SIZE "$out/$2" | awk 'NR == 2 { print $1 }')
+	sites=$($NM -S -C --radix=d "$out/$2" | awk '$4 ~ /^Site[0-9]/ { tot += $2 } END { print tot + 0 }')
+	printf "%-8s text %6d  call sites %6d\n" "$2" "$text" "$sites"
+}
+
+echo "=== text bytes ==="
+build -DSIZE_COMPARE_BASELINE baseline
+build "" sketch
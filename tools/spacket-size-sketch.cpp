@@ -0,0 +1,78 @@
+// Packet encode / decode code built by size-compare.sh twice: through
+// SPacket and ( baseline ) with hand written BufWrite / BufRead chains.
+
+#include "DebugMacros.h"
+#include "SPacket.h"
+#include "Util.h"
+
+using namespace SearchAThing::Arduino;
+
+struct Msg
+{
+	uint16_t id;
+	uint32_t time;
+	int32_t temp;
+	float v;
+	uint16_t flags;
+};
+
+#define MSG_SIZE 16
+
+byte buf[MSG_SIZE];
+Msg msg;
+
+#ifdef SIZE_COMPARE_BASELINE
+
+static void Encode(byte *p, const Msg& m)
+{
+	BufWrite16(p, m.id);
+	BufWrite32(p + 2, m.time);
+	BufWrite32(p + 6, (uint32_t)m.temp);
+	uint32_t bits;
+	memcpy(&bits, &m.v, 4);
+	BufWrite32(p + 10, bits);
+	BufWrite16(p + 14, m.flags);
+}
+
+static void Decode(byte *p, Msg& m)
+{
+	m.id = BufReadUInt16_t(p);
+	m.time = BufReadUInt32_t(p + 2);
+	m.temp = (int32_t)BufReadUInt32_t(p + 6);
+	uint32_t bits = BufReadUInt32_t(p + 10);
+	memcpy(&m.v, &bits, 4);
+	m.flags = BufReadUInt16_t(p + 14);
+}
+
+#else
+
+typedef SPacket<SFIELD(Msg, id), SFIELD(Msg, time), SFIELD(Msg, temp),
+	SFIELD(Msg, v), SFIELD(Msg, flags)> MsgPacket;
+
+static_assert(MsgPacket::WireSize == MSG_SIZE, "wire size");
+
+static void Encode(byte *p, const Msg& m) { MsgPacket::Encode(p, m); }
+static void Decode(byte *p, Msg& m) { MsgPacket::Decode(p, m); }
+
+#endif
+
+// call sites spread over distinct functions as in a sketch
+void Site1() { Encode(buf, msg); }
+void Site2() { Decode(buf, msg); }
+
+void setup()
+{
+	Site1();
+	Site2();
+}
+
+void loop() {}
+
+#ifndef ARDUINO_ARCH_AVR
+// host build has no arduino core main
+int main()
+{
+	setup();
+	return 0;
+}
+#endif